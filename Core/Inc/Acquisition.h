@@ -0,0 +1,153 @@
+// Acquisition.h
+// The configuration of the ADC acquisition path
+// Date: Oct 2025
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include "Buffer.h"
+#include "DmaRing.h"
+#include "Pipeline.h"
+#include "DspStages.h"
+
+enum class AcqMode : uint8_t {
+  Continuous = 0, // ADC1 free-running scan
+  Timed,          // One scan sequence per TIM8 TRGO
+  PwmSync,        // One scan sequence per motor PWM period, in the middle of its off phase
+};
+
+// How getNoseADC turns samples into an amplitude
+enum class Estimator : uint8_t {
+  Average = 0, // Raw codes are the amplitude, smoothed by NoseFilterChain
+  LockIn,      // I/Q demodulation of the carrier, one amplitude per DMA block
+  Goertzel,    // Single-bin Goertzel at the carrier (or its alias), one amplitude per DMA block
+  Oversample,  // Fast conversions decimated by a CIC stage, one wider value per DMA block
+};
+
+// Estimators that compute one value per DMA block in the ADC callbacks
+constexpr bool perBlock(Estimator e) { return e != Estimator::Average; }
+
+// LockIn and Goertzel need the carrier-locked sample clock
+constexpr bool demodulates(Estimator e) { return e == Estimator::LockIn || e == Estimator::Goertzel; }
+
+// Values match the SMPx field (ADC_SAMPLETIME_xxx)
+enum class SampleTime : uint8_t {
+  Cycles1_5 = 0,
+  Cycles7_5,
+  Cycles13_5,
+  Cycles28_5,
+  Cycles41_5,
+  Cycles55_5,
+  Cycles71_5,
+  Cycles239_5,
+};
+
+// Sampling plus 12.5 cycles of conversion, in half ADC clock cycles
+constexpr uint32_t conversionHalfCycles(SampleTime t) {
+  constexpr uint32_t sampling[8] = {3, 15, 27, 57, 83, 111, 143, 479};
+  return sampling[static_cast<uint8_t>(t)] + 25;
+}
+
+// One inductor of the nose array
+struct NoseChannel {
+  uint8_t Channel;  // ADCx_INn
+  int16_t Position; // Lateral offset, right positive; getNosePosition reports in the same unit
+};
+
+// DMA frame order is table order. In dual mode even entries go to ADC1 and
+// odd entries to ADC2, so each pair converts at the same instant.
+constexpr NoseChannel NoseChannels[] = {
+  {4, 50},   // A4, right
+  {15, -50}, // C5, left
+};
+constexpr std::size_t ADCChannelCount = std::size(NoseChannels);
+
+// F1 mapping: IN0-7 are PA0-7, IN8-9 are PB0-1, IN10-15 are PC0-5
+struct AnalogPin {
+  char Port;
+  uint8_t Pin;
+};
+constexpr AnalogPin analogPin(uint8_t channel) {
+  return channel < 8 ? AnalogPin{'A', channel}
+       : channel < 10 ? AnalogPin{'B', static_cast<uint8_t>(channel - 8)}
+       : AnalogPin{'C', static_cast<uint8_t>(channel - 10)};
+}
+
+// Inputs whose pins the board already uses: encoders (IN0/1/6/7), music (IN2),
+// steering servo (IN8), buzzer (IN9) and PPM (IN13)
+constexpr uint16_t BoardChannelMask = 0b0010'0011'1100'0111;
+
+constexpr bool validNoseChannels() {
+  uint16_t seen = 0;
+  for (const auto& c : NoseChannels) {
+    if (c.Channel > 15 || (BoardChannelMask >> c.Channel & 1) || (seen >> c.Channel & 1)) return false;
+    seen |= 1u << c.Channel;
+  }
+  return true;
+}
+
+constexpr struct {
+  AcqMode Mode = AcqMode::Timed;
+  Estimator Amplitude = Estimator::Average;
+  uint32_t CarrierHz = 20000;       // Guide-wire carrier, used by LockIn and Goertzel
+  uint32_t SamplesPerCycle = 4;     // Block estimators sample at this multiple of CarrierHz
+  uint32_t TimerClockHz = 72000000; // TIM8 sits on APB2; TIM4 runs at the same 72 MHz
+  uint32_t MotorPwmHz = 15000;      // TIM4 motor PWM, kept in PwmSync mode
+  // Sequences (frames) per second in Timed and PwmSync modes
+  uint32_t SampleRateHz = Mode == AcqMode::PwmSync ? MotorPwmHz
+                        : demodulates(Amplitude) ? CarrierHz * SamplesPerCycle
+                        : Amplitude == Estimator::Oversample ? 120000 : 12800;
+  // PwmSync keeps the sampling window short so it stays clear of the switching edges
+  SampleTime Sampling = Mode == AcqMode::PwmSync ? SampleTime::Cycles28_5
+                      : perBlock(Amplitude) ? SampleTime::Cycles41_5 : SampleTime::Cycles239_5;
+  std::size_t BlockFrames = BufferSize / 2; // Frames per half of the DMA ring
+  std::size_t CicOrder = 1;         // Oversample: 1 is a boxcar, higher orders add a block of latency each
+  // Bits above 12 in getNoseADC values; 4x oversampling buys about one
+  uint8_t ExtraBits = Amplitude == Estimator::Oversample ? 2 : 0;
+  bool DualADC = true;              // ADC1 (A4) and ADC2 (C5) sample simultaneously
+  uint32_t ADCClockHz = 12000000;   // PCLK2 / 6
+} Acquisition;
+
+// What getNoseADC(..., true) runs over every sample with the Average estimator,
+// e.g. Pipeline<Median<5>, Ema<Fixed::Q15(0.2)>, Biquad<biquadLowpass(500, 12800)>>.
+// DspBiquad runs on CMSIS-DSP when built with USE_CMSIS_DSP and is the
+// portable Biquad otherwise, so the option changes the code, not the response.
+// The 3-tap median drops single-sample motor PWM spikes before the average,
+// and a 500 Hz low-pass smooths what the trimmed average lets through.
+using NoseFilterChain = Pipeline<Median<3>, Trimmed<>, DspBiquad<biquadLowpass(500, Acquisition.SampleRateHz)>>;
+
+// Largest getNoseADC value
+constexpr uint16_t NoseFullScale = (4096u << Acquisition.ExtraBits) - 1;
+
+// Conversions each ADC performs per frame
+constexpr std::size_t ConversionsPerFrame = Acquisition.DualADC ? ADCChannelCount / 2 : ADCChannelCount;
+
+// The DMA ring is the sample history: BufferSize frames of all channels.
+// In dual mode every DMA word packs one ADC1/ADC2 pair.
+using ADCHistory = DmaRing<uint16_t, ADCChannelCount, BufferSize, ConversionsPerFrame>;
+extern ADCHistory ADCRing;
+
+static_assert(Acquisition.TimerClockHz / Acquisition.SampleRateHz - 1 <= 0xFFFF,
+              "SampleRateHz is too low for a 16-bit TIM8 period");
+static_assert(Acquisition.TimerClockHz % Acquisition.SampleRateHz == 0,
+              "SampleRateHz must divide the timer clock for exact sample spacing");
+static_assert(Acquisition.SampleRateHz * conversionHalfCycles(Acquisition.Sampling) * ConversionsPerFrame
+                <= 2 * Acquisition.ADCClockHz,
+              "SampleRateHz is faster than one conversion sequence");
+static_assert(Acquisition.Mode != AcqMode::PwmSync || Acquisition.TimerClockHz / Acquisition.MotorPwmHz % 2 == 0,
+              "Center-aligned TIM4 needs an even number of timer clocks per PWM period");
+static_assert(ADCChannelCount >= 2 && ADCChannelCount <= 8, "The nose array has 2 to 8 inductors");
+static_assert(validNoseChannels(), "Nose channels must be distinct, external and on free pins");
+static_assert(!Acquisition.DualADC || ADCChannelCount % 2 == 0,
+              "Dual ADC mode splits the channels into ADC1/ADC2 pairs");
+static_assert(Acquisition.Amplitude != Estimator::LockIn ||
+                (Acquisition.Mode == AcqMode::Timed && Acquisition.BlockFrames % Acquisition.SamplesPerCycle == 0),
+              "LockIn needs timed sampling and whole carrier cycles per block");
+static_assert(Acquisition.Amplitude != Estimator::Goertzel || Acquisition.Mode == AcqMode::Timed,
+              "Goertzel needs timed sampling for a known bin frequency");
+static_assert(Acquisition.Amplitude == Estimator::Oversample || Acquisition.ExtraBits == 0,
+              "Only Oversample produces values wider than 12 bits");
+static_assert(Acquisition.ExtraBits <= 4, "getNoseADC values are 16 bits");
+static_assert(Acquisition.Amplitude != Estimator::Oversample ||
+                (Acquisition.BlockFrames & (Acquisition.BlockFrames - 1)) == 0,
+              "Oversample rescales the CIC gain by shifting, so BlockFrames must be a power of two");
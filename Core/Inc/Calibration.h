@@ -0,0 +1,57 @@
+// Calibration.h
+// Per-channel min/max calibration with Q15 gain/offset normalization
+// Date: Oct 2025
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Records each channel's range while the car is swept over the wire, then
+// maps [min, max] onto [0, FullScale] with one multiply-shift per reading.
+// Until the first finish() every channel passes through unchanged.
+template<std::size_t Channels, uint16_t FullScale>
+class Calibration {
+public:
+  static constexpr uint16_t MinSpan = 64; // Narrower ranges were not swept and keep the old mapping
+
+  void start() {
+    minVals.fill(UINT16_MAX);
+    maxVals.fill(0);
+    recording = true;
+  }
+
+  void record(std::size_t ch, uint16_t raw) {
+    if (!recording) return;
+    if (raw < minVals[ch]) minVals[ch] = raw;
+    if (raw > maxVals[ch]) maxVals[ch] = raw;
+  }
+
+  // The only divide, once per channel
+  void finish() {
+    for (std::size_t ch = 0; ch < Channels; ch++) {
+      if (maxVals[ch] < minVals[ch] || maxVals[ch] - minVals[ch] < MinSpan) continue;
+      offset[ch] = minVals[ch];
+      gain[ch] = (static_cast<uint32_t>(FullScale) << 15) / (maxVals[ch] - minVals[ch]);
+    }
+    recording = false;
+  }
+
+  bool isRecording() const { return recording; }
+
+  uint16_t apply(std::size_t ch, uint16_t raw) const {
+    uint32_t v = raw > offset[ch] ? raw - offset[ch] : 0;
+    uint64_t scaled = (static_cast<uint64_t>(v) * gain[ch] + (1u << 14)) >> 15;
+    return scaled > FullScale ? FullScale : static_cast<uint16_t>(scaled);
+  }
+
+private:
+  std::array<uint16_t, Channels> minVals{};
+  std::array<uint16_t, Channels> maxVals{};
+  std::array<uint16_t, Channels> offset{};
+  std::array<uint32_t, Channels> gain = [](){
+    std::array<uint32_t, Channels> g{};
+    g.fill(1u << 15);
+    return g;
+  }();
+  bool recording = false;
+};
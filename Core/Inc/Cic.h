@@ -0,0 +1,40 @@
+// Cic.h
+// Integer CIC decimator for oversampled ADC channels
+// Date: Oct 2025
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Order integrator/comb pairs decimating R samples to one, gain R^Order.
+// Integrators are free to wrap: the combs cancel it as long as the output
+// itself fits 32 bits. Order 1 is a plain boxcar sum of the block.
+template<std::size_t Order, std::size_t R>
+class Cic {
+public:
+  static constexpr uint64_t Gain = [](){
+    uint64_t g = 1;
+    for (std::size_t i = 0; i < Order; i++) g *= R;
+    return g;
+  }();
+  static_assert(Order > 0, "CIC needs at least one stage");
+  static_assert(4095 * Gain <= UINT32_MAX, "CIC output overflows 32 bits");
+
+  // Consumes R samples spaced `stride` apart and returns one output
+  uint32_t decimate(const volatile uint16_t* samples, std::size_t stride) {
+    for (std::size_t n = 0; n < R; n++) {
+      integ[0] += samples[n * stride];
+      for (std::size_t k = 1; k < Order; k++) integ[k] += integ[k - 1];
+    }
+    uint32_t y = integ[Order - 1];
+    for (std::size_t k = 0; k < Order; k++) {
+      uint32_t delayed = comb[k];
+      comb[k] = y;
+      y -= delayed;
+    }
+    return y;
+  }
+
+private:
+  uint32_t integ[Order]{};
+  uint32_t comb[Order]{};
+};
@@ -3,9 +3,11 @@
 // Date: Oct 2025
 #pragma once
 #include <vector>
+#include <initializer_list>
 #include <stdint.h>
 #include "Melodies.h"
 #include "Buffer.h"
+#include "Acquisition.h"
 
 class Device {
 public:
@@ -33,7 +35,9 @@ public:
   ~Device() = default;
   
   void delay(uint32_t ms);
+  void idleUntil(uint32_t deadline); // Sleeps until getTick() reaches deadline or an interrupt posts work; 1 ms granularity
   uint32_t getTick();
+  uint32_t getMicros();
   void setLightMode(LightMode mode);
   LightMode getLightMode();
 
@@ -56,12 +60,25 @@ public:
   bool getStopSignal();
   bool getIRSignal();
   uint16_t getNoseADC(NoseID id, bool enableFiltering = false);
-  void setDirection(int32_t rotation);
+  uint16_t getNoseChannel(std::size_t ch, bool enableFiltering = false);
+  int32_t getNosePosition(bool enableFiltering = false);
+  void startCalibration();
+  void finishCalibration();
+  bool isCalibrating();
+  std::size_t pollNose(); // Takes the newest processed block for the nose readings, returns how many arrived
+  uint32_t getNoseStamp(bool enableFiltering = false); // Micros() of the samples behind the nose readings
+  void armLineWatch(uint16_t level); // Lock steering from the ADC watchdog once both outer inductors read below level
+  void disarmLineWatch();
+  bool lineLost(); // Whether the watchdog locked steering since the last call
+  static void setDirection(int32_t rotation); // Static so the watchdog interrupt can lock steering
+  static int32_t getDirection(); // The steering in effect, after clamping and any watchdog lock
   void setMotorEnabled(bool enabled);
   void setPower(int32_t power);
+  int32_t getPower(); // The last power set, after clamping
 
   void sendData(float a, float b);
   void sendData(const std::vector<float>& datas);
+  void sendData(std::initializer_list<float> datas); // For braced lists, without a heap vector
   void sendDataSafely(const std::vector<float>& datas);
 
 private:
@@ -71,6 +88,8 @@ private:
   static constexpr uint8_t vofaEnd[4] = {0x00, 0x00, 0x80, 0x7f};
   void initPWM();
   void initADC();
-  uint16_t getFiltered(Buffer<uint16_t, BufferSize> buffer);
+  void initNosePins();
+  void initSampleTimer();
+  void initPwmSync();
   LightMode devLightMode{LightMode::Show};
 };
@@ -0,0 +1,73 @@
+// DmaRing.h
+// A ring view over a circular DMA buffer, used as ADC history without copying
+// Date: Oct 2025
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// DMA fills `data` frame by frame in circular mode. The write position is
+// recovered from the channel's CNDTR (remaining transfers), so the newest
+// complete frame is [-1] and the oldest is [0], as with RingBuffer.
+template<typename T, std::size_t Channels, std::size_t N, std::size_t TransfersPerFrame = Channels>
+class DmaRing {
+public:
+  static constexpr std::size_t Transfers = N * TransfersPerFrame;
+
+  // A view of one channel, pinned to the head at the time it was taken
+  class Channel {
+  public:
+    std::size_t size() const { return N; }
+
+    T operator[](int index) const {
+      return ring->data[(head + N + index) % N][ch];
+    }
+
+    T getMax() const {
+      T m = ring->data[0][ch];
+      for (std::size_t i = 1; i < N; i++) {
+        T v = ring->data[i][ch];
+        m = std::max(m, v);
+      }
+      return m;
+    }
+    T getMin() const {
+      T m = ring->data[0][ch];
+      for (std::size_t i = 1; i < N; i++) {
+        T v = ring->data[i][ch];
+        m = std::min(m, v);
+      }
+      return m;
+    }
+
+  private:
+    friend class DmaRing;
+    Channel(const DmaRing* ring, std::size_t ch, std::size_t head)
+      : ring(ring), ch(ch), head(head) {}
+
+    const DmaRing* ring;
+    std::size_t ch;
+    std::size_t head;
+  };
+
+  explicit DmaRing(const volatile uint32_t* cndtr) : cndtr(cndtr) {}
+
+  // Frame DMA is currently writing; it may be partially updated
+  std::size_t head() const {
+    return (Transfers - *cndtr) / TransfersPerFrame % N;
+  }
+
+  Channel channel(std::size_t ch) const { return Channel(this, ch, head()); }
+
+  T latest(std::size_t ch) const { return channel(ch)[-1]; }
+
+  // Raw access by ring slot, for processing a block DMA has finished with
+  const volatile T* frame(std::size_t index) const { return data[index]; }
+
+  // Start address for HAL_ADC_Start_DMA and friends
+  uint32_t* target() { return (uint32_t *)data; }
+
+private:
+  alignas(uint32_t) volatile T data[N][Channels]{};
+  const volatile uint32_t* cndtr;
+};
@@ -0,0 +1,66 @@
+// DspStages.h
+// Pipeline stages backed by CMSIS-DSP block kernels when built with USE_CMSIS_DSP
+// Date: Oct 2025
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "Pipeline.h"
+
+#ifdef USE_CMSIS_DSP
+#include "arm_math.h"
+
+// Biquad over whole blocks with arm_biquad_cascade_df1_q15. Samples are
+// scaled into Q15 with two bits of headroom for overshoot, so inputs up to
+// 16 bits lose their low bits; 12-bit codes pass unchanged.
+template<BiquadCoeffs C, uint8_t InputBits = 12>
+class DspBiquad {
+  static_assert(InputBits <= 15, "Samples must fit Q15 with headroom");
+  static constexpr int Shift = 13 - InputBits;
+
+public:
+  DspBiquad() {
+    // CMSIS wants {b0, 0, b1, b2, -a1, -a2}; Q14 values with a post-shift of 1
+    arm_biquad_cascade_df1_init_q15(&instance, 1, coeffs, state, 1);
+  }
+  // instance points at this object's own coeffs and state
+  DspBiquad(const DspBiquad&) = delete;
+  DspBiquad& operator=(const DspBiquad&) = delete;
+  DspBiquad(DspBiquad&&) = delete;
+  DspBiquad& operator=(DspBiquad&&) = delete;
+
+  int32_t push(int32_t x) {
+    pushBlock(&x, 1);
+    return x;
+  }
+
+  void pushBlock(int32_t* samples, std::size_t n) {
+    q15_t block[Chunk];
+    for (std::size_t done = 0; done < n; done += Chunk) {
+      std::size_t count = std::min(Chunk, n - done);
+      for (std::size_t i = 0; i < count; i++) block[i] = toQ15(samples[done + i]);
+      arm_biquad_cascade_df1_q15(&instance, block, block, count);
+      for (std::size_t i = 0; i < count; i++) samples[done + i] = fromQ15(block[i]);
+    }
+  }
+
+private:
+  static constexpr std::size_t Chunk = 32;
+
+  static q15_t toQ15(int32_t x) {
+    return static_cast<q15_t>(std::clamp<int32_t>(Shift >= 0 ? x << Shift : x >> -Shift, 0, INT16_MAX));
+  }
+  static int32_t fromQ15(q15_t y) {
+    return Shift >= 0 ? (y + (1 << Shift >> 1)) >> Shift : y << -Shift;
+  }
+
+  q15_t coeffs[6] = {static_cast<q15_t>(C.b0), 0, static_cast<q15_t>(C.b1), static_cast<q15_t>(C.b2),
+                     static_cast<q15_t>(-C.a1), static_cast<q15_t>(-C.a2)};
+  q15_t state[4]{};
+  arm_biquad_casd_df1_inst_q15 instance;
+};
+#else
+// Without CMSIS-DSP the same response comes from the portable per-sample stage
+template<BiquadCoeffs C, uint8_t InputBits = 12>
+using DspBiquad = Biquad<C>;
+#endif
@@ -0,0 +1,46 @@
+// FixedPoint.h
+// Q15 helpers and integer math for the FPU-less Cortex-M3
+// Date: Oct 2025
+#pragma once
+#include <cstdint>
+
+namespace Fixed {
+  constexpr double Pi = 3.14159265358979323846;
+
+  // Compile-time conversion, so no double arithmetic reaches the target
+  constexpr int16_t Q15(double x) {
+    double v = x * 32768.0;
+    v = v < 0 ? v - 0.5 : v + 0.5;
+    return static_cast<int16_t>(v >= 32767.0 ? 32767.0 : v <= -32768.0 ? -32768.0 : v);
+  }
+
+  constexpr double sin(double x) {
+    while (x > Pi) x -= 2 * Pi;
+    while (x < -Pi) x += 2 * Pi;
+    double term = x, sum = x;
+    for (int n = 1; n < 12; n++) {
+      term *= -x * x / ((2 * n) * (2 * n + 1));
+      sum += term;
+    }
+    return sum;
+  }
+
+  constexpr double cos(double x) { return sin(x + Pi / 2); }
+
+  // Integer square root, rounded down
+  constexpr uint32_t isqrt(uint64_t x) {
+    uint64_t root = 0;
+    uint64_t bit = uint64_t{1} << 62;
+    while (bit > x) bit >>= 2;
+    while (bit != 0) {
+      if (x >= root + bit) {
+        x -= root + bit;
+        root = (root >> 1) + bit;
+      } else {
+        root >>= 1;
+      }
+      bit >>= 2;
+    }
+    return static_cast<uint32_t>(root);
+  }
+}
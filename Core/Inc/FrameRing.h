@@ -0,0 +1,69 @@
+// FrameRing.h
+// A ring of multi-channel frames with one head, stored channel by channel
+// Date: Oct 2025
+#pragma once
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "Segments.h"
+
+// Every push writes all channels of one acquisition under a single head, so
+// frame [-1] never mixes instants. Storage is one contiguous array per
+// channel, which keeps per-channel loops linear. [-1] is the newest frame
+// and [0] the oldest.
+template<std::size_t Channels, std::size_t N, typename T = int32_t>
+class FrameRing {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "FrameRing capacity must be a power of two");
+  static constexpr uint32_t Mask = N - 1;
+
+public:
+  using Frame = std::array<T, Channels>;
+
+  // One channel's history, pinned to the head at the time it was taken
+  class Channel {
+  public:
+    std::size_t size() const { return N; }
+    const T& operator[](int index) const { return values[(head + static_cast<uint32_t>(index)) & Mask]; }
+    const T& getMax() const { return *std::max_element(values, values + N); }
+    const T& getMin() const { return *std::min_element(values, values + N); }
+
+    Segments<const T> segments() const {
+      std::size_t wrap = head & Mask;
+      return {std::span<const T>(values + wrap, N - wrap), std::span<const T>(values, wrap)};
+    }
+
+  private:
+    friend class FrameRing;
+    Channel(const T* values, uint32_t head) : values(values), head(head) {}
+
+    const T* values;
+    uint32_t head;
+  };
+
+  FrameRing() {
+    for (auto& channel : data) channel.fill(T{});
+  }
+
+  void push(const Frame& frame) {
+    uint32_t slot = head & Mask;
+    for (std::size_t ch = 0; ch < Channels; ch++) data[ch][slot] = frame[ch];
+    head++;
+  }
+
+  std::size_t size() const { return N; }
+
+  // The whole frame, with one index computation for all channels
+  Frame operator[](int index) const {
+    uint32_t slot = (head + static_cast<uint32_t>(index)) & Mask;
+    Frame frame;
+    for (std::size_t ch = 0; ch < Channels; ch++) frame[ch] = data[ch][slot];
+    return frame;
+  }
+
+  Channel channel(std::size_t ch) const { return Channel(data[ch].data(), head); }
+
+private:
+  std::array<std::array<T, N>, Channels> data;
+  uint32_t head = 0;
+};
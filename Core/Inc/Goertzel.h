@@ -0,0 +1,37 @@
+// Goertzel.h
+// Fixed-point single-bin amplitude estimator for the inductor channels
+// Date: Oct 2025
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "FixedPoint.h"
+
+// Q15 cos of the bin nearest targetHz in an N-point block sampled at sampleHz.
+// A target above Nyquist is folded onto its alias.
+constexpr int16_t goertzelCos(uint32_t targetHz, uint32_t sampleHz, std::size_t N) {
+  uint32_t f = targetHz % sampleHz;
+  if (2 * f > sampleHz) f = sampleHz - f;
+  uint64_t k = (static_cast<uint64_t>(N) * f * 2 + sampleHz) / (2 * static_cast<uint64_t>(sampleHz));
+  return Fixed::Q15(Fixed::cos(2 * Fixed::Pi * k / N));
+}
+
+// Second-order Goertzel resonator over N samples; CosQ15 selects the bin.
+// State stays in 32 bits, only the coefficient products widen to 64.
+template<std::size_t N, int16_t CosQ15>
+class Goertzel {
+public:
+  // Peak amplitude in ADC codes of the bin, from samples spaced `stride` apart
+  static uint16_t magnitude(const volatile uint16_t* samples, std::size_t stride) {
+    int32_t s1 = 0, s2 = 0;
+    for (std::size_t n = 0; n < N; n++) {
+      int32_t x = static_cast<int32_t>(samples[n * stride]) - 2048; // Mid-scale keeps the state small
+      int32_t s0 = x + static_cast<int32_t>((static_cast<int64_t>(CosQ15) * s1) >> 14) - s2;
+      s2 = s1;
+      s1 = s0;
+    }
+    int64_t power = static_cast<int64_t>(s1) * s1 + static_cast<int64_t>(s2) * s2
+                  - ((static_cast<int64_t>(CosQ15) * s1 * s2) >> 14);
+    if (power < 0) power = 0;
+    return static_cast<uint16_t>(2 * Fixed::isqrt(static_cast<uint64_t>(power)) / N);
+  }
+};
@@ -0,0 +1,92 @@
+// HistoryPyramid.h
+// Full-rate and decimated rings of min/max/mean buckets for long-horizon history
+// Date: Oct 2025
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "FrameRing.h"
+
+// Level 0 keeps the last N samples. Each further level keeps the last N
+// buckets of Ratio buckets from the level below, so level i reaches back
+// N * Ratio^i samples at a fixed N * Levels * 3 values of RAM.
+template<typename T, std::size_t N, std::size_t Levels = 3, std::size_t Ratio = 10>
+class HistoryPyramid {
+public:
+  enum Field : std::size_t {
+    Min = 0,
+    Max,
+    Mean,
+    Fields,
+  };
+  using Level = FrameRing<Fields, N, T>;
+
+  // The first value fills every level, so queries never see a zero start
+  void push(T value) {
+    if (!primed) {
+      for (auto& l : levels) {
+        for (std::size_t k = 0; k < N; k++) l.push({value, value, value});
+      }
+      primed = true;
+    }
+    feed(0, value, value, value);
+  }
+
+  const Level& level(std::size_t i) const { return levels[i]; }
+
+  struct Range {
+    T min, max, mean;
+  };
+
+  // Extremes and mean over the N * bucketSpan(i) samples level i covers
+  Range range(std::size_t i) const {
+    auto [older, newer] = levels[i].channel(Mean).segments();
+    int64_t sum = 0;
+    for (std::span<const T> run : {older, newer}) {
+      for (const T& v : run) sum += v;
+    }
+    return {levels[i].channel(Min).getMin(), levels[i].channel(Max).getMax(),
+            static_cast<T>(sum / static_cast<int64_t>(N))};
+  }
+
+  // Trend of level i's bucket means, Q8 per pushed sample
+  int32_t slope(std::size_t i) const {
+    return slopeQ8(levels[i].channel(Mean).segments()) / static_cast<int32_t>(bucketSpan(i));
+  }
+
+  // Samples covered by one bucket of level i
+  static constexpr std::size_t bucketSpan(std::size_t i) {
+    std::size_t span = 1;
+    while (i--) span *= Ratio;
+    return span;
+  }
+
+private:
+  struct Accumulator {
+    T min, max;
+    int64_t sum;
+    std::size_t count;
+  };
+
+  void feed(std::size_t i, T min, T max, T mean) {
+    levels[i].push({min, max, mean});
+    if (i + 1 == Levels) return;
+    auto& acc = pending[i];
+    if (acc.count == 0) {
+      acc.min = min;
+      acc.max = max;
+      acc.sum = 0;
+    }
+    if (min < acc.min) acc.min = min;
+    if (max > acc.max) acc.max = max;
+    acc.sum += mean;
+    if (++acc.count == Ratio) {
+      acc.count = 0;
+      feed(i + 1, acc.min, acc.max, static_cast<T>(acc.sum / static_cast<int64_t>(Ratio)));
+    }
+  }
+
+  std::array<Level, Levels> levels;
+  std::array<Accumulator, Levels - 1> pending{};
+  bool primed = false;
+};
@@ -0,0 +1,80 @@
+// LineKalman.h
+// Fixed-point Kalman filter for the car's offset from the wire and its heading
+// Date: Oct 2025
+#pragma once
+#include <cstdint>
+
+// Everything is in the units of the measured nose error ("codes") and the
+// nominal step period. Heading is how fast the offset grows, in codes per
+// period at SpeedRef; steering turns it at SteerGain per unit of command.
+struct LineModel {
+  int32_t SpeedRef;     // Motor power at which a period covers one period of travel
+  int32_t SteerGainQ16; // Heading change per period per steering unit at SpeedRef, codes Q16
+  int32_t OffsetNoise;  // Process noise per period, codes
+  int32_t HeadingNoise; // Process noise per period, codes per period
+  int32_t SensorNoise;  // Measurement noise, codes
+};
+
+// Two states, offset y and heading h, in Q8. One measurement, y itself.
+//   y' = y + travel * h
+//   h' = h - travel * SteerGain * steer
+// travel is the distance covered this step relative to one period at
+// SpeedRef. Covariances are 64-bit Q8 codes squared, so no tuning overflows.
+template<LineModel M>
+class LineKalman {
+  static_assert(M.SpeedRef > 0 && M.SensorNoise > 0, "LineModel needs a speed and a sensor noise");
+
+public:
+  // z is the measured error, steer and power the commands in effect since
+  // the last step, dt the time since it and period the nominal spacing
+  void step(int32_t z, int32_t steer, int32_t power, uint32_t dt, uint32_t period) {
+    constexpr int64_t R = static_cast<int64_t>(M.SensorNoise) * M.SensorNoise << 8;
+    if (!primed) {
+      y = z << 8;
+      h = 0;
+      p00 = R;
+      p01 = 0;
+      p11 = R;
+      primed = true;
+    }
+    rate = static_cast<int32_t>((static_cast<int64_t>(power) << 16) / M.SpeedRef);
+    int64_t elapsed = period ? (static_cast<int64_t>(dt) << 16) / period : 1 << 16;
+    int64_t a = rate * elapsed >> 16; // travel, Q16
+    turn = -static_cast<int64_t>(M.SteerGainQ16) * steer >> 8; // Heading change per period at SpeedRef, Q8
+
+    // Predict
+    y += static_cast<int32_t>(a * h >> 16);
+    h += static_cast<int32_t>(a * turn >> 16);
+    p00 += (2 * a * p01 >> 16) + (a * (a * p11 >> 16) >> 16)
+         + (elapsed * M.OffsetNoise * M.OffsetNoise << 8 >> 16);
+    p01 += a * p11 >> 16;
+    p11 += elapsed * M.HeadingNoise * M.HeadingNoise << 8 >> 16;
+
+    // Update
+    int64_t s = p00 + R;
+    int64_t k0 = (p00 << 16) / s;
+    int64_t k1 = (p01 << 16) / s;
+    int64_t innovation = (static_cast<int64_t>(z) << 8) - y;
+    y += static_cast<int32_t>(k0 * innovation >> 16);
+    h += static_cast<int32_t>(k1 * innovation >> 16);
+    p11 -= k1 * p01 >> 16;
+    p00 -= k0 * p00 >> 16;
+    p01 -= k0 * p01 >> 16;
+  }
+
+  void reset() { primed = false; }
+
+  int32_t offset() const { return (y + 128) >> 8; }
+  int32_t heading() const { return (h + 128) >> 8; }
+  // Offset change per period at the current speed, the D term's unit
+  int32_t offsetRate() const { return static_cast<int32_t>(((static_cast<int64_t>(h) * rate >> 16) + 128) >> 8); }
+  // Heading change per period from the current steering
+  int32_t headingRate() const { return static_cast<int32_t>(((turn * rate >> 16) + 128) >> 8); }
+
+private:
+  int32_t y = 0, h = 0;
+  int64_t p00 = 0, p01 = 0, p11 = 0;
+  int64_t rate = 0; // power / SpeedRef, Q16
+  int64_t turn = 0;
+  bool primed = false;
+};
@@ -0,0 +1,42 @@
+// LockIn.h
+// Synchronous (lock-in) amplitude demodulation of the guide-wire carrier
+// Date: Oct 2025
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "FixedPoint.h"
+
+// Samples are taken at exactly M per carrier cycle, so the I/Q references
+// are fixed M-entry Q15 tables and the carrier phase does not matter.
+template<std::size_t M>
+class LockIn {
+  static_assert(M >= 3, "LockIn needs at least 3 samples per carrier cycle");
+public:
+  // Peak carrier amplitude in ADC codes over `count` samples spaced `stride`
+  // apart. count must cover whole carrier cycles so the DC offset cancels.
+  static uint16_t amplitude(const volatile uint16_t* samples, std::size_t stride, std::size_t count) {
+    int64_t i = 0, q = 0;
+    std::size_t k = 0;
+    for (std::size_t n = 0; n < count; n++) {
+      int32_t x = samples[n * stride];
+      i += x * Cos[k];
+      q += x * Sin[k];
+      if (++k == M) k = 0;
+    }
+    i >>= 15;
+    q >>= 15;
+    uint32_t mag = Fixed::isqrt(static_cast<uint64_t>(i * i) + static_cast<uint64_t>(q * q));
+    return static_cast<uint16_t>(2 * mag / count);
+  }
+
+private:
+  static constexpr std::array<int16_t, M> table(double phase) {
+    std::array<int16_t, M> t{};
+    for (std::size_t n = 0; n < M; n++) t[n] = Fixed::Q15(Fixed::cos(2 * Fixed::Pi * n / M + phase));
+    return t;
+  }
+
+  static constexpr std::array<int16_t, M> Cos = table(0);
+  static constexpr std::array<int16_t, M> Sin = table(-Fixed::Pi / 2);
+};
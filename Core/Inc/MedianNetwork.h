@@ -0,0 +1,104 @@
+// MedianNetwork.h
+// Branchless median-of-N selection networks, generated at compile time
+// Date: Oct 2025
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+struct Comparator {
+  uint8_t lo, hi;
+};
+
+namespace MedianNet {
+
+// Batcher's odd-even merge sort for the next power of two, pruned to the
+// comparators that can still move a value into the middle slot. Padding
+// slots would hold +inf, so comparators touching them are dropped too.
+template<std::size_t N>
+struct Plan {
+  static constexpr std::size_t Padded = std::bit_ceil(N);
+  std::array<Comparator, Padded * Padded> net{};
+  std::size_t size = 0;
+
+  constexpr Plan() {
+    std::array<Comparator, Padded * Padded> sort{};
+    std::size_t count = 0;
+    for (std::size_t p = 1; p < Padded; p <<= 1) {
+      for (std::size_t k = p; k >= 1; k >>= 1) {
+        for (std::size_t j = k % p; j + k < Padded; j += 2 * k) {
+          for (std::size_t i = 0; i < std::min(k, Padded - j - k); i++) {
+            if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < N) {
+              sort[count++] = {static_cast<uint8_t>(i + j), static_cast<uint8_t>(i + j + k)};
+            }
+          }
+        }
+      }
+    }
+    // Walk backwards from the median, keeping what feeds it
+    std::array<bool, Padded> needed{};
+    needed[N / 2] = true;
+    std::array<bool, Padded * Padded> keep{};
+    for (std::size_t c = count; c-- > 0;) {
+      if (needed[sort[c].lo] || needed[sort[c].hi]) {
+        keep[c] = true;
+        needed[sort[c].lo] = needed[sort[c].hi] = true;
+      }
+    }
+    for (std::size_t c = 0; c < count; c++) {
+      if (keep[c]) net[size++] = sort[c];
+    }
+  }
+};
+
+template<std::size_t N>
+constexpr Plan<N> plan{};
+
+template<std::size_t N>
+constexpr auto network = [](){
+  std::array<Comparator, plan<N>.size> net{};
+  std::copy_n(plan<N>.net.begin(), net.size(), net.begin());
+  return net;
+}();
+
+// min/max compile to conditional moves, so there is no data-dependent branch
+template<typename T, std::size_t N, std::size_t... I>
+constexpr T select(std::array<T, N> v, std::index_sequence<I...>) {
+  auto exchange = [&v](Comparator c) {
+    T a = v[c.lo], b = v[c.hi];
+    v[c.lo] = std::min(a, b);
+    v[c.hi] = std::max(a, b);
+  };
+  (exchange(network<N>[I]), ...);
+  return v[N / 2];
+}
+
+// 0-1 principle: a comparator network selects the median of every input
+// if it does so for every input of zeros and ones
+template<std::size_t N>
+constexpr bool selectsMedian() {
+  for (uint32_t bits = 0; bits < (1u << N); bits++) {
+    std::array<uint8_t, N> v{};
+    std::size_t ones = 0;
+    for (std::size_t i = 0; i < N; i++) {
+      v[i] = bits >> i & 1;
+      ones += v[i];
+    }
+    uint8_t expected = ones > N / 2;
+    if (select(v, std::make_index_sequence<network<N>.size()>{}) != expected) return false;
+  }
+  return true;
+}
+
+} // namespace MedianNet
+
+// Median of N samples, N in 3, 5, 7 or 9
+template<std::size_t N, typename T>
+constexpr T median(const std::array<T, N>& samples) {
+  static_assert(N == 3 || N == 5 || N == 7 || N == 9, "Median networks cover 3, 5, 7 and 9 taps");
+  static_assert(MedianNet::selectsMedian<N>(), "Median network is wrong");
+  return MedianNet::select(samples, std::make_index_sequence<MedianNet::network<N>.size()>{});
+}
@@ -0,0 +1,17 @@
+// Micros.h
+// A 32-bit microsecond clock from TIM6 and its overflow count
+// Date: Oct 2025
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+void Micros_Overflow(void); // TIM6 update interrupt, every 65.536 ms
+uint32_t Micros(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,140 @@
+// Pipeline.h
+// Compile-time chains of integer filter stages
+// Date: Oct 2025
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include "FixedPoint.h"
+#include "MedianNetwork.h"
+#include "TrimmedEma.h"
+
+// A stage is any type with `int32_t push(int32_t)` returning its output,
+// optionally with `void pushBlock(int32_t*, std::size_t)` filtering in place.
+// Pipeline<A, B, C> feeds each sample through A, B and C in order; the
+// stages are concrete members, so the whole chain inlines.
+template<typename... Stages>
+class Pipeline {
+public:
+  int32_t push(int32_t x) {
+    std::apply([&x](auto&... stage){ ((x = stage.push(x)), ...); }, stages);
+    return x;
+  }
+
+  // Runs a block through each stage in turn, in place. Stages with their own
+  // pushBlock (e.g. DspBiquad) take the whole block at once, the rest go
+  // sample by sample; the result equals n calls to push.
+  int32_t pushBlock(int32_t* samples, std::size_t n) {
+    std::apply([&](auto&... stage){ (runBlock(stage, samples, n), ...); }, stages);
+    return samples[n - 1];
+  }
+
+private:
+  template<typename Stage>
+  static void runBlock(Stage& stage, int32_t* samples, std::size_t n) {
+    if constexpr (requires { stage.pushBlock(samples, n); }) {
+      stage.pushBlock(samples, n);
+    } else {
+      for (std::size_t i = 0; i < n; i++) samples[i] = stage.push(samples[i]);
+    }
+  }
+
+  std::tuple<Stages...> stages;
+};
+
+// Median of the last N samples through a sorting network, for impulse
+// spikes such as motor PWM edges. Samples are clamped to 16 bits. The
+// first sample fills the window, so the start is not pulled towards 0.
+template<std::size_t N>
+class Median {
+public:
+  int32_t push(int32_t x) {
+    uint16_t sample = static_cast<uint16_t>(std::clamp<int32_t>(x, 0, UINT16_MAX));
+    if (!primed) {
+      window.fill(sample);
+      primed = true;
+    }
+    window[next] = sample;
+    next = next + 1 == N ? 0 : next + 1;
+    return median(window);
+  }
+
+private:
+  std::array<uint16_t, N> window{};
+  std::size_t next = 0;
+  bool primed = false;
+};
+
+// First-order exponential average, Alpha in Q15, state in Q8
+template<int16_t Alpha>
+class Ema {
+  static_assert(Alpha > 0, "Ema needs a positive Alpha");
+
+public:
+  int32_t push(int32_t x) {
+    int32_t target = x << 8;
+    if (!primed) {
+      state = target;
+      primed = true;
+    }
+    state += static_cast<int32_t>((static_cast<int64_t>(target - state) * Alpha) >> 15);
+    return (state + 128) >> 8;
+  }
+
+private:
+  int32_t state = 0;
+  bool primed = false;
+};
+
+// Normalized biquad coefficients in Q14, which covers |c| < 2
+struct BiquadCoeffs {
+  int32_t b0, b1, b2, a1, a2;
+};
+
+// RBJ low-pass, evaluated at compile time
+constexpr BiquadCoeffs biquadLowpass(double cutoffHz, double sampleHz, double q = 0.7071) {
+  double w0 = 2 * Fixed::Pi * cutoffHz / sampleHz;
+  double cosw = Fixed::cos(w0);
+  double alpha = Fixed::sin(w0) / (2 * q);
+  double a0 = 1 + alpha;
+  auto q14 = [a0](double c){
+    double v = c / a0 * 16384.0;
+    return static_cast<int32_t>(v < 0 ? v - 0.5 : v + 0.5);
+  };
+  return {q14((1 - cosw) / 2), q14(1 - cosw), q14((1 - cosw) / 2), q14(-2 * cosw), q14(1 - alpha)};
+}
+
+// Direct form I, samples carried in Q8 so low cutoffs keep their precision
+template<BiquadCoeffs C>
+class Biquad {
+public:
+  int32_t push(int32_t x) {
+    int32_t x0 = x << 8;
+    int64_t acc = static_cast<int64_t>(C.b0) * x0 + static_cast<int64_t>(C.b1) * x1 + static_cast<int64_t>(C.b2) * x2
+                - static_cast<int64_t>(C.a1) * y1 - static_cast<int64_t>(C.a2) * y2;
+    int32_t y0 = static_cast<int32_t>(acc >> 14);
+    x2 = x1;
+    x1 = x0;
+    y2 = y1;
+    y1 = y0;
+    return (y0 + 128) >> 8;
+  }
+
+private:
+  int32_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+};
+
+// The streaming trimmed average as a stage
+template<typename Filter = TrimmedEma<>>
+class Trimmed {
+public:
+  int32_t push(int32_t x) {
+    filter.push(static_cast<uint16_t>(std::clamp<int32_t>(x, 0, UINT16_MAX)));
+    return filter.value();
+  }
+
+private:
+  Filter filter;
+};
@@ -0,0 +1,68 @@
+// RingBuffer.h
+// A power-of-two ring with constant-time sliding min/max
+// Date: Oct 2025
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "Segments.h"
+
+// [-1] is the newest element and [0] the oldest. Positions are masked
+// instead of taken modulo N, and two monotonic deques of sequence numbers
+// keep the window's max and min at their fronts.
+template<typename T, std::size_t N>
+class RingBuffer {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two");
+  static constexpr uint32_t Mask = N - 1;
+
+public:
+  // Starts full of T{}
+  RingBuffer() {
+    for (std::size_t i = 0; i < N; i++) push(T{});
+  }
+
+  void push(T item) {
+    uint32_t seq = pushed++;
+    buffer[seq & Mask] = item;
+    maxQueue.push(buffer, seq, [&](const T& kept){ return kept <= item; });
+    minQueue.push(buffer, seq, [&](const T& kept){ return kept >= item; });
+  }
+
+  std::size_t size() const { return N; }
+
+  const T& getMax() const { return buffer[maxQueue.front() & Mask]; }
+  const T& getMin() const { return buffer[minQueue.front() & Mask]; }
+
+  // Read-only, since writing through it would bypass the deques
+  const T& operator[](int index) const {
+    return buffer[(pushed + static_cast<uint32_t>(index)) & Mask];
+  }
+
+  Segments<const T> segments() const {
+    std::size_t wrap = pushed & Mask;
+    return {std::span<const T>(buffer).subspan(wrap), std::span<const T>(buffer).first(wrap)};
+  }
+
+private:
+  // Sequence numbers of the remaining extremum candidates, oldest first
+  class Monotonic {
+  public:
+    template<typename Dominated>
+    void push(const std::array<T, N>& values, uint32_t seq, Dominated dominated) {
+      if (head != tail && seqs[head & Mask] == seq - N) head++; // Left the window
+      while (head != tail && dominated(values[seqs[(tail - 1) & Mask] & Mask])) tail--;
+      seqs[tail++ & Mask] = seq;
+    }
+    uint32_t front() const { return seqs[head & Mask]; }
+
+  private:
+    std::array<uint32_t, N> seqs{};
+    uint32_t head = 0;
+    uint32_t tail = 0;
+  };
+
+  std::array<T, N> buffer{};
+  uint32_t pushed = 0;
+  Monotonic maxQueue;
+  Monotonic minQueue;
+};
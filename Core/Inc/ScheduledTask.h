@@ -3,292 +3,215 @@
 // Date: Oct 2025
 #pragma once
 #include <cstdint>
-#include <functional>
+#include <cstddef>
 #include <algorithm>
 #include <limits>
-#include <vector>
-#include <memory>
-#include <unordered_set>
-#include <utility>
+#include <new>
+#include <type_traits>
 #include <array>
+#include <bitset>
 #include "Device.h"
 
 constexpr uint32_t INF_RUNS = std::numeric_limits<uint32_t>::max();
-
-// The Base Class
-class ScheduledTaskBase {
+constexpr std::size_t MaxTasks = 16; // Scheduler pool size
+constexpr std::size_t TaskCallbackSize = 4 * sizeof(void*); // Bytes of captures a task may keep
+
+// Task callbacks take the Device and, optionally, the step index
+template<typename F>
+concept TaskCallable = std::is_invocable_v<F&, Device&> || std::is_invocable_v<F&, Device&, std::size_t>;
+
+// A callback held inside the task, never on the heap. Captureless lambdas
+// become a plain function pointer, so such tasks can be built at compile
+// time; lambdas with captures are copied into the buffer, which is why they
+// must be trivially copyable (references, pointers and numbers are).
+class TaskCallback {
 public:
-  explicit ScheduledTaskBase(uint32_t period = 0)
-    : period_ms(period), last_tick_ms(0), task_id(UINT32_MAX), finished_flag(false) {}
-  virtual ~ScheduledTaskBase() = default;
-
-  // tick: perform scheduled work
-  virtual void tick(Device& dev, uint32_t now) = 0;
-
-  // finished(): whether the task finished and should be removed
-  virtual bool finished() const { return finished_flag; }
+  constexpr TaskCallback() = default;
+
+  template<typename F>
+    requires TaskCallable<F> && (!std::is_same_v<F, TaskCallback>)
+  constexpr TaskCallback(F f) {
+    static_assert(std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>,
+                  "Task callbacks are copied as bytes; capture references or plain values");
+    static_assert(sizeof(F) <= TaskCallbackSize && alignof(F) <= alignof(void*),
+                  "Task callback captures too much for TaskCallbackSize");
+    if constexpr (std::is_empty_v<F> && std::is_default_constructible_v<F>) {
+      invoke = [](TaskCallback&, Device& dev, std::size_t step){
+        F f{};
+        call(f, dev, step);
+      };
+    } else {
+      ::new (static_cast<void*>(storage)) F(f);
+      invoke = [](TaskCallback& self, Device& dev, std::size_t step){
+        call(*std::launder(reinterpret_cast<F*>(self.storage)), dev, step);
+      };
+    }
+  }
 
-  // Getters / setters
-  uint32_t period_ms;
-  uint32_t last_tick_ms;
-  uint32_t task_id;
+  explicit constexpr operator bool() const { return invoke != nullptr; }
 
-protected:
-  void markFinished() { finished_flag = true; }
+  void operator()(Device& dev, std::size_t step) { invoke(*this, dev, step); }
 
 private:
-  bool finished_flag;
+  template<typename F>
+  static void call(F& f, Device& dev, std::size_t step) {
+    if constexpr (std::is_invocable_v<F&, Device&, std::size_t>) {
+      f(dev, step);
+    } else {
+      f(dev);
+    }
+  }
+
+  void (*invoke)(TaskCallback&, Device&, std::size_t) = nullptr;
+  alignas(void*) unsigned char storage[TaskCallbackSize]{};
 };
 
 
-// Flexible ScheduledTask: supports either averaged step durations (from period)
+// Flexible Task: supports either averaged step durations (from period)
 // or custom per-step durations via array. Supports initial delay and max_runs.
-template <size_t Steps>
-class ScheduledTask : public ScheduledTaskBase {
-  static_assert(Steps > 0, "ScheduledTask Steps must be > 0");
+// A plain value: the Scheduler copies it into its pool, and the factories
+// below are constexpr for captureless callbacks.
+class Task {
 public:
-  using StepCb = std::function<void(Device&, size_t)>;
-
-  // 1) Averaged steps: provide total period (ms) and callback.
-  //    Each step gets ceil(period / Steps) ms (at least 1).
-  ScheduledTask(uint32_t period,
-                StepCb cb,
-                uint32_t max_runs = std::numeric_limits<uint32_t>::max())
-    : ScheduledTaskBase(period),
-      cb(cb),
-      cur_step(0),
-      initial_delay_ms(0),
-      started(true),
-      max_runs(max_runs),
-      run_count(0)
-  {
-    init_average_steps(period);
-  }
+  constexpr Task() = default;
 
-  // 2) Averaged steps + delayed start + optional max_runs
-  ScheduledTask(uint32_t initial_delay,
-                uint32_t period,
-                StepCb cb,
-                uint32_t max_runs = std::numeric_limits<uint32_t>::max())
-    : ScheduledTaskBase(period),
+  // Averaged steps: each of `steps` gets ceil(period / steps) ms (at least 1)
+  constexpr Task(uint32_t initial_delay, uint32_t period, std::size_t steps, TaskCallback cb, uint32_t max_runs)
+    : period_ms(period),
       cb(cb),
-      cur_step(0),
+      steps(steps),
+      step_period_ms(std::max<uint32_t>(1, (period + steps - 1) / steps)),
       initial_delay_ms(initial_delay),
-      started(false),
-      max_runs(max_runs),
-      run_count(0)
-  {
-    init_average_steps(period);
-  }
-
-  // 3) Custom per-step durations (array), optional initial delay & max_runs.
-  ScheduledTask(const std::array<uint32_t, Steps>& step_durations,
-                StepCb cb,
-                uint32_t initial_delay = 0,
-                uint32_t max_runs = std::numeric_limits<uint32_t>::max())
-    : ScheduledTaskBase(0),
-      cb(cb),
-      cur_step(0),
-      step_durations(step_durations.begin(), step_durations.end()),
+      max_runs(max_runs) {}
+
+  // Custom per-step durations; the table is not copied, so it must outlive
+  // the task (e.g. a constexpr array)
+  constexpr Task(const uint32_t* step_durations, std::size_t steps, TaskCallback cb,
+                 uint32_t initial_delay, uint32_t max_runs)
+    : cb(cb),
+      steps(steps),
+      step_durations(step_durations),
       initial_delay_ms(initial_delay),
-      started(initial_delay == 0),
-      max_runs(max_runs),
-      run_count(0)
-  {
-    // ensure each step duration is at least 1 ms
-    for (auto &d : this->step_durations) d = std::max<uint32_t>(1, d);
-  }
+      max_runs(max_runs) {}
 
-  // Convenience constructor for callbacks of type std::function<void(Device&)>
-  ScheduledTask(uint32_t period,
-                std::function<void(Device&)> f,
-                uint32_t max_runs = std::numeric_limits<uint32_t>::max())
-    : ScheduledTask(period, StepCb([f](Device& d, size_t){ f(d); }), max_runs) {}
-
-  ScheduledTask(uint32_t initial_delay,
-                uint32_t period,
-                std::function<void(Device&)> f,
-                uint32_t max_runs = std::numeric_limits<uint32_t>::max())
-    : ScheduledTask(initial_delay, period, StepCb([f](Device& d, size_t){ f(d); }), max_runs) {}
-
-  ScheduledTask(const std::array<uint32_t, Steps>& step_durations,
-                std::function<void(Device&)> f,
-                uint32_t initial_delay = 0,
-                uint32_t max_runs = std::numeric_limits<uint32_t>::max())
-    : ScheduledTask(step_durations, StepCb([f](Device& d, size_t){ f(d); }), initial_delay, max_runs) {}
-
-  void tick(Device& dev, uint32_t now) override {
+  // tick: perform scheduled work
+  void tick(Device& dev, uint32_t now) {
     // If not started due to initial delay, check the delay first.
     if (!started) {
-      if ((now - last_tick_ms) >= initial_delay_ms) {
-        // advance last_tick by the delay consumed
-        last_tick_ms += initial_delay_ms;
-        started = true;
-      } else {
-        return; // still waiting for delay
-      }
+      if ((now - last_tick_ms) < initial_delay_ms) return; // still waiting for delay
+      // advance last_tick by the delay consumed
+      last_tick_ms += initial_delay_ms;
+      started = true;
     }
 
-    // If we have per-step durations vector, use it; otherwise use step_period_ms
-    while (!reached_limit() && (now - last_tick_ms) >= current_step_duration()) {
-      uint32_t dt = current_step_duration();
-      last_tick_ms += dt;
+    // Step sequences catch up on missed steps; single-step tasks run at most once per pass
+    while (!finished() && (now - last_tick_ms) >= current_step_duration()) {
+      last_tick_ms += current_step_duration();
 
       // call back with current step index
       cb(dev, cur_step);
 
       ++run_count;
-      if (reached_limit()) {
-        markFinished(); // schedule for removal by Scheduler
-        break;
-      }
-
-      // advance step
-      cur_step = (cur_step + 1) % Steps;
+      cur_step = cur_step + 1 == steps ? 0 : cur_step + 1;
+      if (steps == 1) break;
     }
   }
 
-  bool finished() const override {
-    return ScheduledTaskBase::finished();
+  // finished(): whether the task reached max_runs and should be removed
+  bool finished() const { return run_count >= max_runs; }
+
+  // The tick at which tick() will next do work
+  uint32_t nextDue() const {
+    return last_tick_ms + (started ? 0 : initial_delay_ms) + current_step_duration();
   }
 
-protected:
-  StepCb cb;
-  size_t cur_step;
+  explicit constexpr operator bool() const { return static_cast<bool>(cb); }
 
-  // per-step durations in ms (size Steps). If empty, we use step_period_ms.
-  std::vector<uint32_t> step_durations;
-  uint32_t step_period_ms = 0; // used when step_durations empty
+  // Getters / setters
+  uint32_t period_ms = 0;
+  uint32_t last_tick_ms = 0;
+  uint32_t task_id = UINT32_MAX;
 
-  uint32_t initial_delay_ms;
-  bool started;
+private:
+  TaskCallback cb;
+  std::size_t steps = 1;
+  std::size_t cur_step = 0;
 
-  uint32_t max_runs;
-  uint32_t run_count;
+  const uint32_t* step_durations = nullptr; // If null, every step takes step_period_ms
+  uint32_t step_period_ms = 1;
 
-  bool reached_limit() const {
-    return run_count >= max_runs;
-  }
+  uint32_t initial_delay_ms = 0;
+  bool started = false;
+
+  uint32_t max_runs = INF_RUNS;
+  uint32_t run_count = 0;
 
   uint32_t current_step_duration() const {
-    if (!step_durations.empty()) return step_durations[cur_step];
+    if (step_durations) return std::max<uint32_t>(1, step_durations[cur_step]);
     return step_period_ms;
   }
-
-  void init_average_steps(uint32_t period) {
-    // average/ceil period across Steps, ensure at least 1 ms per step.
-    step_period_ms = std::max<uint32_t>(1, (period + Steps - 1) / Steps);
-    step_durations.clear();
-  }
 };
 
-
-// Specialization for Steps == 1 (simpler and efficient)
-template <>
-class ScheduledTask<1> : public ScheduledTaskBase {
-public:
-  using StepCb = std::function<void(Device&)>;
-
-  // Normal (no delay) with optional max_runs
-  ScheduledTask(uint32_t period, StepCb cb, uint32_t max_runs = std::numeric_limits<uint32_t>::max())
-    : ScheduledTaskBase(period), cb_wrap([cb](Device& d, size_t){ cb(d); }),
-      initial_delay_ms(0), started(true), max_runs(max_runs), run_count(0) {}
-
-  // Delayed start
-  ScheduledTask(uint32_t initial_delay, uint32_t period, StepCb cb, uint32_t max_runs = std::numeric_limits<uint32_t>::max())
-    : ScheduledTaskBase(period), cb_wrap([cb](Device& d, size_t){ cb(d); }),
-      initial_delay_ms(initial_delay), started(false), max_runs(max_runs), run_count(0) {}
-
-  void tick(Device& dev, uint32_t now) override {
-    if (!started) {
-      if ((now - last_tick_ms) >= initial_delay_ms) {
-        last_tick_ms += initial_delay_ms;
-        started = true;
-      } else {
-        return;
-      }
-    }
-
-    uint32_t dur = (single_step_duration > 0) ? single_step_duration : period_ms;
-    if (dur == 0) dur = 1;
-    if (!reached_limit() && (now - last_tick_ms) >= dur) {
-      last_tick_ms += dur;
-      cb_wrap(dev, 0);
-      ++run_count;
-      if (reached_limit()) markFinished();
-    }
-  }
-
-  bool finished() const override { return ScheduledTaskBase::finished(); }
-
-private:
-  std::function<void(Device&, size_t)> cb_wrap;
-  uint32_t initial_delay_ms;
-  bool started;
-  uint32_t single_step_duration = 0; // if >0 use instead of period_ms
-  uint32_t max_runs;
-  uint32_t run_count;
-
-  bool reached_limit() const { return run_count >= max_runs; }
-};
+static_assert(std::is_trivially_copyable_v<Task>, "The Scheduler pool copies tasks as bytes");
 
 
+// Keeps up to MaxTasks tasks in a fixed pool; nothing is allocated. A binary
+// heap orders the slots by due tick, so a pass only touches tasks that are due.
 class Scheduler {
 public:
-  using TaskPtr = std::unique_ptr<ScheduledTaskBase>;
-
-  Scheduler(uint32_t start_tick) : start_tick(start_tick), next_id(1), in_run(false), current_task(UINT32_MAX) {}
+  Scheduler(uint32_t start_tick) : start_tick(start_tick) {}
 
   // Add a task. If called during runOnce(), the task is queued and will be activated
-  // after the current run loop. Returns assigned task id.
-  uint32_t addTask(TaskPtr t) {
-    if (!t) return UINT32_MAX;
-    uint32_t id = next_id++;
-    t->task_id = id;
-    if (in_run) {
-      pending_add.emplace_back(std::move(t));
-    } else {
-      tasks.emplace_back(std::move(t));
-    }
+  // after the current run loop. Returns assigned task id, or UINT32_MAX if the
+  // task is empty or the pool is full.
+  uint32_t addTask(const Task& t) {
+    uint32_t id = addTaskWithID(t, next_id);
+    if (id != UINT32_MAX) ++next_id;
     return id;
   }
 
-  uint32_t addTaskWithID(TaskPtr t, uint32_t id) {
+  uint32_t addTaskWithID(const Task& t, uint32_t id) {
     if (!t) return UINT32_MAX;
-    t->task_id = id;
-    if (in_run) {
-      pending_add.emplace_back(std::move(t));
-    } else {
-      tasks.emplace_back(std::move(t));
+    for (std::size_t i = 0; i < MaxTasks; i++) {
+      if (used[i]) continue;
+      pool[i] = t;
+      pool[i].task_id = id;
+      seq[i] = added++;
+      used.set(i);
+      if (in_run) {
+        pending.set(i);
+      } else {
+        push(i);
+      }
+      return id;
     }
-    return id;
+    return UINT32_MAX;
   }
 
   // Add and initialize last_tick_ms
-  uint32_t addTaskAndInit(TaskPtr t) {
-    if (!t) return UINT32_MAX;
-    t->last_tick_ms = this->start_tick;
-    return addTask(std::move(t));
+  uint32_t addTaskAndInit(Task t) {
+    t.last_tick_ms = this->start_tick;
+    return addTask(t);
   }
-  uint32_t addTaskAndInit(TaskPtr t, uint32_t last_tick) {
-    if (!t) return UINT32_MAX;
-    t->last_tick_ms = last_tick;
-    return addTask(std::move(t));
+  uint32_t addTaskAndInit(Task t, uint32_t last_tick) {
+    t.last_tick_ms = last_tick;
+    return addTask(t);
   }
 
   // Add and initialize and set ID
-  uint32_t addTaskAndInitWithID(TaskPtr t, uint32_t last_tick, uint32_t id) {
-    if (!t) return UINT32_MAX;
-    t->last_tick_ms = last_tick;
-    return addTaskWithID(std::move(t), id);
+  uint32_t addTaskAndInitWithID(Task t, uint32_t last_tick, uint32_t id) {
+    t.last_tick_ms = last_tick;
+    return addTaskWithID(t, id);
   }
 
   // Request removal of a task by id. If called during runOnce(), removal takes
   // effect immediately for subsequent ticks in the same run (the task is skipped),
-  // and memory is reclaimed after run finishes.
+  // and the slot is reclaimed after run finishes.
   void removeTask(uint32_t id) {
     if (id == UINT32_MAX) return;
-    pending_remove.insert(id);
+    for (std::size_t i = 0; i < MaxTasks; i++) {
+      if (used[i] && pool[i].task_id == id) removing.set(i);
+    }
     if (!in_run) {
       // not in run -> flush immediately
       flushPending();
@@ -298,35 +221,50 @@ public:
   // Return the id of the task currently being ticked (or UINT32_MAX if none).
   uint32_t currentTaskId() const { return current_task; }
 
-  // Run single scheduling iteration: tick all tasks with "now".
+  // Run single scheduling iteration: tick the tasks due at "now", earliest first.
   // This should be called from your main loop repeatedly.
   void runOnce(Device& dev, uint32_t now) {
     in_run = true;
-    for (size_t i = 0; i < tasks.size(); ++i) {
-      TaskPtr &t = tasks[i];
-      if (!t) continue;
-      uint32_t id = t->task_id;
-      if (pending_remove.find(id) != pending_remove.end()) continue;
-      current_task = id;
-      t->tick(dev, now);
-      // If task reached its internal limit and marked finished, schedule its removal
-      if (t->finished()) {
-        pending_remove.insert(id);
-      }
+    last_now = now;
+    // Take every due task out first, so each ticks at most once per pass
+    std::array<uint8_t, MaxTasks> ready;
+    std::size_t count = 0;
+    while (heap_size && static_cast<int32_t>(now - due[heap[0]]) >= 0) {
+      std::pop_heap(heap.begin(), heap.begin() + heap_size, later());
+      ready[count++] = heap[--heap_size];
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      std::size_t slot = ready[i];
+      if (removing[slot]) continue;
+      Task& t = pool[slot];
+      current_task = t.task_id;
+      t.tick(dev, now);
+      // If task reached its internal limit, schedule its removal
+      if (t.finished()) removing.set(slot);
       current_task = UINT32_MAX;
     }
     in_run = false;
+    for (std::size_t i = 0; i < count; ++i) {
+      if (!removing[ready[i]]) push(ready[i]);
+    }
     flushPending();
   }
 
+  // The earliest tick at which a task is due; it may already be past. With
+  // no tasks, a tick half the counter range after the last pass.
+  uint32_t nextDeadline() const {
+    return heap_size ? due[heap[0]] : last_now + INT32_MAX;
+  }
+
   // Convenience: number of active tasks (after pending flushed)
-  size_t taskCount() const { return tasks.size(); }
+  size_t taskCount() const { return used.count(); }
 
   // Remove all tasks
   void clearAll() {
-    tasks.clear();
-    pending_add.clear();
-    pending_remove.clear();
+    used.reset();
+    pending.reset();
+    removing.reset();
+    heap_size = 0;
   }
 
   void resetTime(uint32_t tick) {
@@ -335,106 +273,113 @@ public:
 
 private:
   uint32_t start_tick;
-  uint32_t next_id;
-  bool in_run;
-  uint32_t current_task;
+  uint32_t next_id = 1;
+  bool in_run = false;
+  uint32_t current_task = UINT32_MAX;
+  uint32_t last_now = 0;
+  uint32_t added = 0; // Counts adds, so ties can go to the older task
+
+  std::array<Task, MaxTasks> pool{};
+  std::bitset<MaxTasks> used;     // Slot holds a task
+  std::bitset<MaxTasks> pending;  // Added during a run, joins the heap after it
+  std::bitset<MaxTasks> removing; // Skipped for the rest of the run, freed after it
+
+  // Min-heap of slots by due tick; ties go to the task added first, as the
+  // flat list used to order them. Slots are reused, so that is seq, not the slot
+  std::array<uint8_t, MaxTasks> heap{};
+  std::size_t heap_size = 0;
+  std::array<uint32_t, MaxTasks> due{}; // Cached nextDue() of each queued slot
+  std::array<uint32_t, MaxTasks> seq{}; // Value of added when the slot was filled
+
+  // std heaps are max-heaps, so order by "later"; the subtraction keeps it wrap-safe
+  struct Later {
+    const Scheduler* s;
+    bool operator()(uint8_t a, uint8_t b) const {
+      int32_t d = static_cast<int32_t>(s->due[a] - s->due[b]);
+      if (d == 0) d = static_cast<int32_t>(s->seq[a] - s->seq[b]);
+      return d > 0;
+    }
+  };
+  Later later() const { return Later{this}; }
 
-  std::vector<TaskPtr> tasks;
-  std::vector<TaskPtr> pending_add;
-  std::unordered_set<uint32_t> pending_remove;
+  void push(std::size_t slot) {
+    due[slot] = pool[slot].nextDue();
+    heap[heap_size++] = static_cast<uint8_t>(slot);
+    std::push_heap(heap.begin(), heap.begin() + heap_size, later());
+  }
 
-  // integrate pending adds and remove flagged tasks
+  // integrate pending adds and free removed slots
   void flushPending() {
-    if (!pending_remove.empty()) {
-      tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
-                                [&](const TaskPtr &t){
-                                  return !t || pending_remove.find(t->task_id) != pending_remove.end();
-                                }),
-                  tasks.end());
-      pending_remove.clear();
+    if (removing.any()) {
+      used &= ~removing;
+      pending &= ~removing;
+      auto end = std::remove_if(heap.begin(), heap.begin() + heap_size,
+                                [this](uint8_t slot){ return removing[slot]; });
+      heap_size = end - heap.begin();
+      std::make_heap(heap.begin(), heap.begin() + heap_size, later());
+      removing.reset();
     }
-    if (!pending_add.empty()) {
-      for (auto &pt : pending_add) {
-        if (pt) tasks.emplace_back(std::move(pt));
-      }
-      pending_add.clear();
+    for (std::size_t i = 0; pending.any() && i < MaxTasks; i++) {
+      if (pending[i]) push(i);
     }
+    pending.reset();
   }
 };
 
 
 // Factory helpers
-inline std::unique_ptr<ScheduledTask<1>> makeTask(
+template<TaskCallable F>
+constexpr Task makeTask(
     uint32_t period_ms,
-    std::function<void(Device&)> cb,
+    F cb,
     uint32_t max_runs = INF_RUNS)
 {
-    return std::make_unique<ScheduledTask<1>>(period_ms, cb, max_runs);
+    return Task(0, period_ms, 1, cb, max_runs);
 }
 
-inline std::unique_ptr<ScheduledTask<1>> makeTask(
+template<TaskCallable F>
+constexpr Task makeTask(
     uint32_t initial_delay,
     uint32_t period_ms,
-    std::function<void(Device&)> cb,
+    F cb,
     uint32_t max_runs = INF_RUNS)
 {
-    return std::make_unique<ScheduledTask<1>>(initial_delay, period_ms, cb, max_runs);
+    return Task(initial_delay, period_ms, 1, cb, max_runs);
 }
 
-template <size_t Steps>
-inline std::unique_ptr<ScheduledTask<Steps>> makeStepTask(
+template <size_t Steps, TaskCallable F>
+constexpr Task makeStepTask(
     uint32_t period_ms,
-    typename ScheduledTask<Steps>::StepCb cb,
+    F cb,
     uint32_t max_runs = INF_RUNS)
 {
-    return std::make_unique<ScheduledTask<Steps>>(period_ms, cb, max_runs);
+    static_assert(Steps > 0, "Task Steps must be > 0");
+    return Task(0, period_ms, Steps, cb, max_runs);
 }
 
-template <size_t Steps>
-inline std::unique_ptr<ScheduledTask<Steps>> makeStepTask(
+template <size_t Steps, TaskCallable F>
+constexpr Task makeStepTask(
     uint32_t initial_delay,
     uint32_t period_ms,
-    typename ScheduledTask<Steps>::StepCb cb,
+    F cb,
     uint32_t max_runs = INF_RUNS)
 {
-    return std::make_unique<ScheduledTask<Steps>>(initial_delay, period_ms, cb, max_runs);
+    static_assert(Steps > 0, "Task Steps must be > 0");
+    return Task(initial_delay, period_ms, Steps, cb, max_runs);
 }
 
-template <size_t Steps>
-inline std::unique_ptr<ScheduledTask<Steps>> makeStepTask(
+template <size_t Steps, TaskCallable F>
+constexpr Task makeStepTask(
     const std::array<uint32_t, Steps>& step_durations,
-    typename ScheduledTask<Steps>::StepCb cb,
+    F cb,
     uint32_t initial_delay = 0,
     uint32_t max_runs = INF_RUNS)
 {
-    return std::make_unique<ScheduledTask<Steps>>(step_durations, cb, initial_delay, max_runs);
-}
-
-template <size_t Steps>
-inline std::unique_ptr<ScheduledTask<Steps>> makeStepTask(
-    uint32_t period_ms,
-    std::function<void(Device&)> cb,
-    uint32_t max_runs = INF_RUNS)
-{
-    return std::make_unique<ScheduledTask<Steps>>(period_ms, cb, max_runs);
-}
-
-template <size_t Steps>
-inline std::unique_ptr<ScheduledTask<Steps>> makeStepTask(
-    uint32_t initial_delay,
-    uint32_t period_ms,
-    std::function<void(Device&)> cb,
-    uint32_t max_runs = INF_RUNS)
-{
-    return std::make_unique<ScheduledTask<Steps>>(initial_delay, period_ms, cb, max_runs);
+    static_assert(Steps > 0, "Task Steps must be > 0");
+    return Task(step_durations.data(), Steps, cb, initial_delay, max_runs);
 }
 
-template <size_t Steps>
-inline std::unique_ptr<ScheduledTask<Steps>> makeStepTask(
-    const std::array<uint32_t, Steps>& step_durations,
-    std::function<void(Device&)> cb,
-    uint32_t initial_delay = 0,
-    uint32_t max_runs = INF_RUNS)
-{
-    return std::make_unique<ScheduledTask<Steps>>(step_durations, cb, initial_delay, max_runs);
-}
+// The task keeps a pointer to the durations, so a temporary would dangle
+template <size_t Steps, TaskCallable F>
+Task makeStepTask(const std::array<uint32_t, Steps>&& step_durations, F cb,
+                  uint32_t initial_delay = 0, uint32_t max_runs = INF_RUNS) = delete;
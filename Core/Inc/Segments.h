@@ -0,0 +1,32 @@
+// Segments.h
+// Ring contents as two contiguous spans, and block kernels that walk them
+// Date: Oct 2025
+#pragma once
+#include <cstdint>
+#include <span>
+
+// Ring contents, oldest to newest, as two contiguous runs: older ends at the
+// wrap and newer ends at the newest element. Either may be empty.
+template<typename T>
+struct Segments {
+  std::span<T> older;
+  std::span<T> newer;
+};
+
+// Least-squares slope of the contents against their position, oldest
+// first, in Q8 units per element. Two pointer loops, no modulo.
+template<typename T>
+int32_t slopeQ8(Segments<const T> contents) {
+  int64_t n = 0, sumY = 0, sumXY = 0;
+  for (std::span<const T> run : {contents.older, contents.newer}) {
+    for (const T& y : run) {
+      sumY += y;
+      sumXY += n * y;
+      n++;
+    }
+  }
+  if (n < 2) return 0;
+  int64_t sumX = n * (n - 1) / 2;
+  int64_t sumXX = (n - 1) * n * (2 * n - 1) / 6;
+  return static_cast<int32_t>((n * sumXY - sumX * sumY) * 256 / (n * sumXX - sumX * sumX));
+}
@@ -0,0 +1,47 @@
+// SpscRing.h
+// A lock-free single-producer/single-consumer ring for ISR-to-task handoff
+// Date: Oct 2025
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// The producer (an interrupt) only writes head, the consumer (the main loop)
+// only writes tail. Each side publishes its index with release and reads the
+// other's with acquire, so a popped slot is always completely written and a
+// slot is never reused while it is being read. Nothing disables interrupts.
+template<typename T, std::size_t N>
+class SpscRing {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free);
+  static constexpr uint32_t Mask = N - 1;
+
+public:
+  // Producer side. When full the item is dropped: the consumer is N behind
+  bool push(const T& item) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == N) return false;
+    slots[h & Mask] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Copies up to `max` items, oldest first, and returns the count
+  std::size_t pop(T* out, std::size_t max) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t available = head.load(std::memory_order_acquire) - t;
+    std::size_t n = available < max ? available : max;
+    for (std::size_t i = 0; i < n; i++) out[i] = slots[(t + i) & Mask];
+    tail.store(t + n, std::memory_order_release);
+    return n;
+  }
+
+  std::size_t size() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+
+private:
+  T slots[N]{};
+  std::atomic<uint32_t> head{0};
+  std::atomic<uint32_t> tail{0};
+};
@@ -0,0 +1,48 @@
+// StatsBuffer.h
+// A RingBuffer that keeps its window's sum and sum of squares
+// Date: Oct 2025
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "RingBuffer.h"
+#include "FixedPoint.h"
+
+// Each push adds the new value and subtracts the one it evicts, so the
+// window's mean, variance and standard deviation are O(1). Values must be
+// integral; squares are accumulated in 64 bits. The ring is a private base,
+// so no push can reach it without updating the sums.
+template<typename T, std::size_t N>
+class StatsBuffer : private RingBuffer<T, N> {
+public:
+  using RingBuffer<T, N>::size;
+  using RingBuffer<T, N>::getMax;
+  using RingBuffer<T, N>::getMin;
+  using RingBuffer<T, N>::operator[];
+  using RingBuffer<T, N>::segments;
+
+  void push(T item) {
+    T evicted = (*this)[0];
+    sum += static_cast<int64_t>(item) - evicted;
+    sumSq += static_cast<uint64_t>(static_cast<int64_t>(item) * item)
+           - static_cast<uint64_t>(static_cast<int64_t>(evicted) * evicted);
+    RingBuffer<T, N>::push(item);
+  }
+
+  int64_t getSum() const { return sum; }
+  int32_t mean() const { return static_cast<int32_t>(sum / static_cast<int64_t>(N)); }
+
+  // Population variance, from N * sum(x^2) - sum(x)^2 to stay exact
+  uint64_t variance() const {
+    uint64_t spread = sumSq * N - static_cast<uint64_t>(sum * sum);
+    return spread / (static_cast<uint64_t>(N) * N);
+  }
+
+  uint32_t stddev() const { return Fixed::isqrt(variance()); }
+
+  // How fast the window is trending, Q8 per push
+  int32_t slope() const { return slopeQ8(segments()); }
+
+private:
+  int64_t sum = 0;    // The zero-filled start contributes nothing
+  uint64_t sumSq = 0;
+};
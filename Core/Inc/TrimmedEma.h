@@ -0,0 +1,37 @@
+// TrimmedEma.h
+// Streaming trimmed, exponentially weighted average of ADC samples
+// Date: Oct 2025
+#pragma once
+#include <cstdint>
+#include "FixedPoint.h"
+
+// The streaming form of a 64-sample trimmed average with 1.1x weights:
+// each push winsorizes the sample to Spread mean absolute deviations around
+// the estimate, then moves the estimate by Alpha, i.e. 1 - 1 / 1.1.
+// State is Q8 codes; reading it is a shift.
+template<int16_t Alpha = Fixed::Q15(1.0 - 1.0 / 1.1), int32_t Spread = 2, int32_t MinBand = 8>
+class TrimmedEma {
+public:
+  void push(uint16_t sample) {
+    int32_t x = static_cast<int32_t>(sample) << 8;
+    if (!primed) {
+      mean = x;
+      primed = true;
+      return;
+    }
+    int32_t err = x - mean;
+    int32_t band = dev * Spread;
+    if (band < (MinBand << 8)) band = MinBand << 8;
+    int32_t clipped = err > band ? band : err < -band ? -band : err;
+    mean += static_cast<int32_t>((static_cast<int64_t>(clipped) * Alpha) >> 15);
+    int32_t spread = (err < 0 ? -err : err) - dev;
+    dev += static_cast<int32_t>((static_cast<int64_t>(spread) * Alpha) >> 15);
+  }
+
+  uint16_t value() const { return static_cast<uint16_t>((mean + 128) >> 8); }
+
+private:
+  int32_t mean = 0; // Q8
+  int32_t dev = 0;  // Q8 mean absolute deviation
+  bool primed = false;
+};
@@ -4,25 +4,44 @@
 #include <cstdint>
 #include <cmath>
 #include <cstdlib>
-#include <utility>
 #include "App.h"
 #include "Device.h"
 #include "ScheduledTask.h"
+#include "StatsBuffer.h"
+#include "HistoryPyramid.h"
+#include "FrameRing.h"
+#include "LineKalman.h"
 #include "Melodies.h"
 
 constexpr uint8_t runMode = 0;
 constexpr int32_t SpeedBase = 650;
+// Nose readings carry Acquisition.ExtraBits more bits than the 12-bit codes the zones are tuned in
+constexpr int32_t NoseScale = 1 << Acquisition.ExtraBits;
 
 constexpr struct {
   uint8_t Lights[20]{1, 2, 4, 8, 4, 2, 1, 2, 4, 8, 4, 2, 1, 5, 10, 5, 10, 5, 10, 0};
   uint32_t MusicTaskID = 2147480000;
   std::size_t BufferSize = 4;
-  std::size_t sBufferSize = 20;
+  std::size_t sBufferSize = 16;
+  std::size_t HistorySize = 16; // Buckets per ErrHistory level
+  uint32_t CollectPeriod = 5; // ms, the spacing the D gains were tuned at
+  int32_t PositionToCodes = 40; // Array position unit to the R - L code scale the gains are tuned in
+  // Offset/heading model for Config.UseKalman, in error codes per CollectPeriod
+  LineModel Line{SpeedBase, 3277 * NoseScale, 2 * NoseScale, 4 * NoseScale, 40 * NoseScale};
 } Setting;
 
-Buffer<int32_t, Setting.BufferSize> LBuffer;
-Buffer<int32_t, Setting.BufferSize> RBuffer;
-Buffer<int32_t, Setting.sBufferSize> ErrBuffer;
+// One frame per collection, so L, R, position and stamp always share an instant
+enum NoseSlot : std::size_t {
+  Left = 0,
+  Right,
+  Position, // Interpolated, filled with more than two inductors
+  Stamp,    // Micros() bit pattern; subtract as uint32_t
+  NoseSlots,
+};
+FrameRing<NoseSlots, Setting.BufferSize> NoseFrames;
+StatsBuffer<int32_t, Setting.sBufferSize> ErrBuffer;
+HistoryPyramid<int32_t, Setting.HistorySize> ErrHistory; // 0.8 s, 8 s and 80 s of the 50 ms error
+LineKalman<Setting.Line> LineEstimate; // Stepped with every collected frame
 
 struct Params {
   float Kp = 0.0f;
@@ -74,7 +93,15 @@ struct {
   uint32_t BrakingTime = 200;
   int32_t BrakingSpeed = -600; // This can be linear decreasing
   bool UseFilter = false;
+  bool UseLineWatch = false; // Lock steering from the ADC watchdog interrupt instead of waiting for the control task
+  uint16_t LineLostLevel = 800; // Raw ADC code both outer inductors must fall below
+  bool UseCalibration = false; // Sweep the car over the wire until enabled; zones are then in normalized codes
   bool UseAnalysis = false; // Enable Analysis to switch different Track Conditions
+  bool UseVariance = false; // Treat a high error variance as Straight
+  uint32_t StraightVariance = 250000; // In 12-bit codes squared
+  bool UseTrend = false; // Take the curve gains while the error is still growing
+  int32_t TrendSlope = 40; // Error growth per 50 ms over the ErrBuffer window, in 12-bit codes
+  bool UseKalman = false; // Control on the estimated offset and its rate instead of raw differences
   bool UseRelay = false;
   uint8_t StopPassNeeded = 2;
 } Config;
@@ -100,37 +127,44 @@ struct {
   float Kp = Config.Default.Kp;
   float Ki = Config.Default.Ki;
   float Kd = Config.Default.Kd;
-  int32_t DeadZone = Config.Default.DeadZone;
-  int32_t StraightZone = Config.Default.StraightZone;
-  int32_t OutZone = Config.Default.OutZone;
+  int32_t DeadZone = Config.Default.DeadZone * NoseScale;
+  int32_t StraightZone = Config.Default.StraightZone * NoseScale;
+  int32_t OutZone = Config.Default.OutZone * NoseScale;
   int32_t Speed = Config.Default.Speed;
   uint8_t StopPassed = 0;
   ControlMode Control = ControlMode::PID;
 } State;
 
+// Steering error `index` samples back: R - L for a pair, the interpolated position for an array
+int32_t noseError(int index) {
+  auto frame = NoseFrames[index];
+  if constexpr (ADCChannelCount > 2) {
+    return frame[Position] * Setting.PositionToCodes * NoseScale;
+  }
+  if (State.Control == ControlMode::DOS) {
+    return frame[Right] - frame[Left] / (frame[Right] + frame[Right]);
+  }
+  return frame[Right] - frame[Left];
+}
+
+// Built at compile time; every addTask copies a fresh one into the pool
 [[maybe_unused]]
-const auto CreatePlayRunningAbout = [](){
-  return makeStepTask<2304>(38400, [](Device& dev, size_t step){
-    dev.playNote(Melody::RunningAbout[step]);
-    dev.playLight(Melody::RunningAbout[step] != Melody::Note::STOP);
-  });
-};
+constexpr Task PlayRunningAbout = makeStepTask<2304>(38400, [](Device& dev, size_t step){
+  dev.playNote(Melody::RunningAbout[step]);
+  dev.playLight(Melody::RunningAbout[step] != Melody::Note::STOP);
+});
 
 [[maybe_unused]]
-const auto CreatePlayLevelComplete = [](){
-  return makeStepTask<42>(5400, [](Device& dev, size_t step){
-    dev.playNote(Melody::LevelComplete[step]);
-    dev.playLight((step & 1) || step > 28);
-  }, 42);
-};
+constexpr Task PlayLevelComplete = makeStepTask<42>(5400, [](Device& dev, size_t step){
+  dev.playNote(Melody::LevelComplete[step]);
+  dev.playLight((step & 1) || step > 28);
+}, 42);
 
 [[maybe_unused]]
-const auto CreatePlayYouHaveDied = [](){
-  return makeStepTask<156>(2600, [](Device& dev, size_t step){
-    dev.playNote(Melody::YouHaveDied[step]);
-    dev.playLight(Melody::YouHaveDied[step] == Melody::Note::STOP);
-  }, 156);
-};
+constexpr Task PlayYouHaveDied = makeStepTask<156>(2600, [](Device& dev, size_t step){
+  dev.playNote(Melody::YouHaveDied[step]);
+  dev.playLight(Melody::YouHaveDied[step] == Melody::Note::STOP);
+}, 156);
 
 void App() {
   Device device;
@@ -138,7 +172,9 @@ void App() {
   // capture a single start tick to initialize tasks so they won't fire immediately
   uint32_t start_tick = device.getTick();
 
-  Scheduler scheduler(start_tick);
+  static Scheduler scheduler(start_tick); // Static so the task pool is counted in .bss, not the 1 KB main stack
+
+  if (Config.UseCalibration) device.startCalibration();
 
   // Task: Board IO
   auto boardIOTaskID = scheduler.addTaskAndInit(
@@ -275,22 +311,23 @@ void App() {
 
   // Task: Enable Switch IO
   auto enableIOTaskID = scheduler.addTaskAndInit(
-    makeTask(50, [&scheduler](Device& dev){
+    makeTask(50, [](Device& dev){
       static bool enabledPrev = false;
       bool enabledNow = dev.isEnabled();
       // Start
       if (enabledNow && !enabledPrev) {
-        auto Start = makeTask(Config.StartDelay, 1, [&scheduler](Device& dev){
+        if (dev.isCalibrating()) dev.finishCalibration();
+        auto Start = makeTask(Config.StartDelay, 1, [](Device& dev){
           dev.setMotorEnabled(true);
           dev.setPower(Config.Straight.Speed);
           State.Started = true;
           if (State.MusicPlaying != 1) {
             scheduler.removeTask(Setting.MusicTaskID);
-            scheduler.addTaskAndInitWithID(CreatePlayRunningAbout(), dev.getTick(), Setting.MusicTaskID);
+            scheduler.addTaskAndInitWithID(PlayRunningAbout, dev.getTick(), Setting.MusicTaskID);
             State.MusicPlaying = 1;
           }
         }, 1);
-        scheduler.addTaskAndInit(std::move(Start), dev.getTick());
+        scheduler.addTaskAndInit(Start, dev.getTick());
       }
       // Speed Adjusting
       if (State.Started && enabledNow) {
@@ -375,26 +412,37 @@ void App() {
 
   // Task: ADC Data Collection
   auto dataCollectionTaskID = scheduler.addTaskAndInit(
-    makeTask(20, 5, [](Device& dev){
-      LBuffer.push(dev.getNoseADC(Device::NoseID::L, Config.UseFilter));
-      RBuffer.push(dev.getNoseADC(Device::NoseID::R, Config.UseFilter));
+    makeTask(20, Setting.CollectPeriod, [](Device& dev){
+      dev.pollNose();
+      NoseFrames.push({
+        dev.getNoseADC(Device::NoseID::L, Config.UseFilter),
+        dev.getNoseADC(Device::NoseID::R, Config.UseFilter),
+        ADCChannelCount > 2 ? dev.getNosePosition(Config.UseFilter) : 0,
+        static_cast<int32_t>(dev.getNoseStamp(Config.UseFilter)),
+      });
+      uint32_t dt = static_cast<uint32_t>(NoseFrames[-1][Stamp]) - static_cast<uint32_t>(NoseFrames[-2][Stamp]);
+      LineEstimate.step(noseError(-1), Device::getDirection(), dev.getPower(), dt, Setting.CollectPeriod * 1000);
+      // Re-armed every period, on whichever outer inductor is stronger now
+      if (Config.UseLineWatch && Config.SteerEnabled && State.Started) dev.armLineWatch(Config.LineLostLevel);
     })
   );
   
   // Task: Statistic Data Collection
   auto sdataCollectionTaskID = scheduler.addTaskAndInit(
-    makeTask(20, 50, [](Device& dev){
-      int32_t latest_err = State.Control == ControlMode::DOS ? (RBuffer[-1] - LBuffer[-1] / (RBuffer[-1] + RBuffer[-1])) : RBuffer[-1] - LBuffer[-1];
-      ErrBuffer.push(latest_err);
+    makeTask(20, 50, [](Device&){
+      int32_t err = noseError(-1);
+      ErrBuffer.push(err);
+      ErrHistory.push(err);
     })
   );
 
   // Task: PD control for direction & Send debug messages
   auto controlTaskID = scheduler.addTaskAndInit(
     makeTask(20, 20, [&](Device& dev){
-      uint16_t ad_left = LBuffer[-1], ad_right = RBuffer[-1];
-      int32_t latest_err = State.Control == ControlMode::DOS ? (RBuffer[-1] - LBuffer[-1] / (RBuffer[-1] + RBuffer[-1])) : RBuffer[-1] - LBuffer[-1];
-      int32_t previous_err = State.Control == ControlMode::DOS ? (RBuffer[-2] - LBuffer[-2] / (RBuffer[-2] + RBuffer[-2])) : RBuffer[-2] - LBuffer[-2];
+      auto latest = NoseFrames[-1];
+      int32_t ad_left = latest[Left], ad_right = latest[Right];
+      int32_t latest_err = Config.UseKalman ? LineEstimate.offset() : noseError(-1);
+      int32_t previous_err = noseError(-2);
 
       [[maybe_unused]]
       uint16_t stateFlag = 0;
@@ -411,26 +459,16 @@ void App() {
         }
       }
       // Staistic
-      /*
-      int64_t sum = 0;
-      uint64_t sum_sq = 0;
-
-      for (size_t i = 1; i <= Setting.sBufferSize; ++i) {
-          int32_t value = ErrBuffer[-i];
-          sum += value;
-          sum_sq += (uint64_t)value * (uint64_t)value;
+      if (Config.UseVariance && ErrBuffer.variance() > static_cast<uint64_t>(Config.StraightVariance) * NoseScale * NoseScale) {
+        State.Condition = Track::Straight;
+        State.Control = ControlMode::PID;
+        stateFlag = 2500;
+      }
+      if (Config.UseTrend && std::abs(ErrBuffer.slope()) > (Config.TrendSlope * NoseScale << 8)) {
+        State.Condition = Track::Mid;
+        State.Control = ControlMode::PID;
+        stateFlag = 3200;
       }
-
-      int32_t mean = sum / Setting.sBufferSize;
-      uint64_t variance = (sum_sq / Setting.sBufferSize) - (mean * mean); 
-      */
-
-      // if (State.Condition == Track::Mid && ad_left + ad_right > 4000 && ad_left > 1500 && ad_right > 1500) {
-      // if (variance > 250000) {
-      //   State.Condition = Track::Straight;
-      //   State.Control = ControlMode::PID;
-      //   stateFlag = 2500;
-      // }
 
       const auto& config = [&]() -> const auto& {
         switch (State.Condition) {
@@ -443,11 +481,12 @@ void App() {
       State.Kp = config.Kp;
       State.Ki = config.Ki;
       State.Kd = config.Kd;
-      State.DeadZone = config.DeadZone;
-      State.StraightZone = config.StraightZone;
-      State.OutZone = config.OutZone;
+      State.DeadZone = config.DeadZone * NoseScale;
+      State.StraightZone = config.StraightZone * NoseScale;
+      State.OutZone = config.OutZone * NoseScale;
       State.Speed = config.Speed;
       if (std::abs(latest_err) < State.DeadZone) State.Control = ControlMode::Stop;
+      if (dev.lineLost()) State.Control = ControlMode::Max; // The watchdog already locked; keep it this period
 
       // Integral is removed temporarily
       // constexpr float dt = 0.005f;
@@ -455,14 +494,21 @@ void App() {
       // constexpr float integralMax = 2000.0f;
       // constexpr float integralMin = -2000.0f;
 
-      float P = static_cast<float>(latest_err);
+      float P = static_cast<float>(latest_err) / NoseScale;
 
       // integral += static_cast<float>(latest_err) * dt;
       // integral = std::clamp(integral, integralMin, integralMax);
       // float I = integral;
 
+      // Rescale the difference to the nominal spacing, which the scheduler only approximates
+      uint32_t dt = static_cast<uint32_t>(latest[Stamp]) - static_cast<uint32_t>(NoseFrames[-2][Stamp]);
       float D = 0.0f;
-      D = latest_err - previous_err;
+      if (Config.UseKalman) {
+        D = static_cast<float>(LineEstimate.offsetRate()) / NoseScale; // Already per CollectPeriod
+      } else {
+        D = static_cast<float>(latest_err - previous_err) / NoseScale;
+        if (dt) D *= static_cast<float>(Setting.CollectPeriod * 1000) / dt;
+      }
 
       float pid_out = State.Kp * P + /*State.Ki * I*/ + State.Kd * D;
 
@@ -493,13 +539,18 @@ void App() {
         dev.setDirection(0); // Steer not enabled
       }
 
-      dev.sendData({(float)ad_left, (float)ad_right, (float)latest_err, (float)stateFlag, P, D, (float)(dev.switchStatus() * 100)});
+      uint32_t age = dev.getMicros() - static_cast<uint32_t>(latest[Stamp]); // Sample age at actuation, us
+
+      // Error trend over the last 8 s in codes per 50 ms, for spotting where curves build up
+      float trend = static_cast<float>(ErrHistory.slope(1)) / 256 / NoseScale;
+
+      dev.sendData({(float)ad_left / NoseScale, (float)ad_right / NoseScale, (float)latest_err / NoseScale, (float)stateFlag, P, D, (float)(dev.switchStatus() * 100), (float)age, trend});
     })
   );
 
   // Task: Add Task Check Stop when it's proper
   auto stopTriggerTaskID = scheduler.addTaskAndInit(
-    makeTask(50, [&scheduler](Device& dev){
+    makeTask(50, [](Device& dev){
       // Task: Check if reached the stop
       auto checkStop = makeTask(5000, 5, [](Device& dev){
         if (Config.UseStop) {
@@ -510,7 +561,7 @@ void App() {
         }
       });
       if ((Config.UseStop || Config.UseRelay) && dev.isEnabled()) {
-        scheduler.addTaskAndInit(std::move(checkStop), dev.getTick());
+        scheduler.addTaskAndInit(checkStop, dev.getTick());
         scheduler.removeTask(scheduler.currentTaskId());
       }
     })
@@ -558,13 +609,14 @@ void App() {
       scheduler.removeTask(Setting.MusicTaskID);
       scheduler.resetTime(now);
       stopped = true;
+      device.disarmLineWatch();
       device.setDirection(0);
-      scheduler.addTaskAndInit(std::move(brake));
+      scheduler.addTaskAndInit(brake);
       scheduler.addTaskAndInit(createStop());
-      scheduler.addTaskAndInit(std::move(endShow));
-      scheduler.addTaskAndInit(std::move(relayBuzz));
-      scheduler.addTaskAndInit(CreatePlayLevelComplete());
+      scheduler.addTaskAndInit(endShow);
+      scheduler.addTaskAndInit(relayBuzz);
+      scheduler.addTaskAndInit(PlayLevelComplete);
     }
-    device.delay(1);
+    device.idleUntil(scheduler.nextDeadline());
   }
 }
@@ -2,35 +2,98 @@
 // A simple C++ enscapsulation of the device functions
 // Date: Oct 2025
 #include <cmath>
+#include <array>
+#include <algorithm>
 #include <cstdint>
 #include <climits>
+#include <bit>
 #include "stm32f1xx_hal.h"
 #include "Device.h"
 #include "Buffer.h"
+#include "Acquisition.h"
+#include "LockIn.h"
+#include "Goertzel.h"
+#include "Cic.h"
+#include "Calibration.h"
+#include "Micros.h"
+#include "SpscRing.h"
 #include "main.h"
 #include "tim.h"
 #include "adc.h"
 #include "usart.h"
 
-Buffer<uint16_t, BufferSize> BufferA4;
-Buffer<uint16_t, BufferSize> BufferC5;
-volatile uint16_t ADC_RawValue[ADCChannelCount];
+// Channels follow NoseChannels
+ADCHistory ADCRing(&DMA1_Channel1->CNDTR);
+// One processed DMA block, handed from the ADC callbacks to pollNose
+struct NoseBlock {
+  uint32_t stamp; // Micros() when the block's last frame was transferred
+  uint16_t amplitude[ADCChannelCount];
+};
+SpscRing<NoseBlock, 32> NoseBlocks;
+// Newest block taken by pollNose; only the main loop touches it
+NoseBlock LatestBlock{};
+// TIM6 overflows, in units of 0x10000 us
+volatile uint32_t MicrosHigh;
+// Analog watchdog state; the level is in raw 12-bit codes
+volatile bool LineLost;
+volatile uint16_t LineLostLevel;
+volatile uint8_t WatchedNose; // Table index of the outer inductor the watchdog is on
+// Center-aligned TIM4 counts each PWM period up and down, halving the compare range
+constexpr uint32_t MotorShift = Acquisition.Mode == AcqMode::PwmSync ? 1 : 0;
+// Set by interrupts that hand the main loop work, so idleUntil returns early
+volatile bool WakePending;
+// Last clamped setPower argument; the compare register alone loses the sign
+int32_t MotorPower;
+// Per-channel filter chains, fed every sample of each block
+NoseFilterChain NoseFilter[ADCChannelCount];
+// Normalization applied to every nose reading, identity until calibrated
+Calibration<ADCChannelCount, NoseFullScale> NoseCalibration;
+
+static_assert(static_cast<uint32_t>(SampleTime::Cycles239_5) == ADC_SAMPLETIME_239CYCLES_5);
+static_assert(ADC_CHANNEL_15 == 15 && ADC_REGULAR_RANK_1 == 1); // NoseChannels are used as raw numbers
 
 // Functional
 
 Device::Device() {
+  HAL_TIM_Base_Start_IT(&htim_RC); // 1 MHz free-running, the update interrupt extends it to 32 bits
   initADC();
   initPWM();
+#ifndef NDEBUG
+  HAL_DBGMCU_EnableDBGSleepMode(); // Keep the debugger attached through idleUntil; costs the WFI savings
+#endif
 }
 
 void Device::delay(uint32_t ms) {
   HAL_Delay(ms);
 }
 
+void Device::idleUntil(uint32_t deadline) {
+  // The 1 kHz HAL tick interrupt serves as the compare: each tick wakes the
+  // core and the deadline is checked again, so tasks are released on the
+  // first tick at or after their deadline and wake-ups have 1 ms granularity.
+  // Deadlines are whole ticks anyway, so no TIM6 compare is armed; the cost
+  // is up to 1000 idle wake-ups a second. With PRIMASK set, an interrupt
+  // still ends WFI but only runs once it is cleared, so a post between the
+  // check and WFI cannot be slept through.
+  __disable_irq();
+  while (static_cast<int32_t>(HAL_GetTick() - deadline) < 0 && !WakePending) {
+    __WFI();
+    __enable_irq();
+    __ISB();
+    __disable_irq();
+  }
+  WakePending = false;
+  __enable_irq();
+}
+
 uint32_t Device::getTick() {
   return HAL_GetTick();
 }
 
+uint32_t Device::getMicros() {
+  return Micros();
+}
+
 void Device::setLightMode(LightMode mode) {
   this->devLightMode = mode;
 }
@@ -143,68 +206,134 @@ bool Device::getIRSignal() {
   return !HAL_GPIO_ReadPin(IR_GPIO_Port, IR_Pin);
 }
 
+// Table index of the outermost inductor on either side
+static constexpr std::size_t outermostNose(bool right) {
+  std::size_t index = 0;
+  for (std::size_t i = 1; i < ADCChannelCount; i++) {
+    if (right ? NoseChannels[i].Position > NoseChannels[index].Position
+              : NoseChannels[i].Position < NoseChannels[index].Position) index = i;
+  }
+  return index;
+}
+
 uint16_t Device::getNoseADC(NoseID id, bool enableFiltering) {
   switch (id) {
     case NoseID::L:
-      return enableFiltering ? getFiltered(BufferC5) : ADC_RawValue[1];
+      return getNoseChannel(outermostNose(false), enableFiltering);
     case NoseID::R:
-      return enableFiltering ? getFiltered(BufferA4) : ADC_RawValue[0];
+      return getNoseChannel(outermostNose(true), enableFiltering);
     default:
       return 0;
   }
 }
 
-uint16_t Device::getFiltered(Buffer<uint16_t, BufferSize> buffer) {
-  const size_t count = buffer.size();
-  if (count == 0) return 0;
-  
-  uint16_t minVals[4] = {UINT16_MAX, UINT16_MAX, UINT16_MAX, UINT16_MAX};
-  uint16_t maxVals[4] = {0, 0, 0, 0};
-  
-  for (size_t i = 0; i < count; i++) {
-    uint16_t val = buffer[i];
-    for (int j = 0; j < 4; j++) {
-      if (val < minVals[j]) {
-        for (int k = 3; k > j; k--) minVals[k] = minVals[k - 1];
-        minVals[j] = val;
-        break;
-      }
-    }
-    for (int j = 0; j < 4; j++) {
-      if (val > maxVals[j]) {
-        for (int k = 3; k > j; k--) maxVals[k] = maxVals[k - 1];
-        maxVals[j] = val;
-        break;
-      }
-    }
+uint16_t Device::getNoseChannel(std::size_t ch, bool enableFiltering) {
+  if (ch >= ADCChannelCount) return 0;
+  uint16_t raw;
+  if (perBlock(Acquisition.Amplitude) || enableFiltering) {
+    raw = LatestBlock.amplitude[ch]; // All channels from the same block
+  } else {
+    raw = ADCRing.latest(ch);
   }
-  
-  uint64_t weightedSum = 0;
-  uint64_t weightSum = 0;
-  const float base = 1.1f;
-  float weight = 1.0f;
-  
-  for (size_t i = 0; i < count; i++) {
-    uint16_t val = buffer[i];
-    bool isMinMax = false;
-    for (int j = 0; j < 4; j++) {
-      if (val == minVals[j] || val == maxVals[j]) {
-        isMinMax = true;
-        break;
-      }
-    }
-    if (isMinMax) continue;
-    uint64_t w = static_cast<uint64_t>(weight + 0.5f);
-    weightedSum += static_cast<uint64_t>(val) * w;
-    weightSum += w;
-    weight *= base;
+  NoseCalibration.record(ch, raw);
+  return NoseCalibration.apply(ch, raw);
+}
+
+void Device::startCalibration() {
+  NoseCalibration.start();
+}
+
+void Device::finishCalibration() {
+  NoseCalibration.finish();
+}
+
+bool Device::isCalibrating() {
+  return NoseCalibration.isRecording();
+}
+
+std::size_t Device::pollNose() {
+  NoseBlock batch[8];
+  std::size_t total = 0;
+  while (std::size_t n = NoseBlocks.pop(batch, std::size(batch))) {
+    LatestBlock = batch[n - 1];
+    total += n;
   }
-  
-  if (weightSum == 0) {
-    return buffer[-1];
+  return total;
+}
+
+uint32_t Device::getNoseStamp(bool enableFiltering) {
+  if (perBlock(Acquisition.Amplitude) || enableFiltering) {
+    return LatestBlock.stamp;
   }
-  
-  return static_cast<uint16_t>(weightedSum / weightSum);
+  return Micros(); // The ring's newest frame is at most one sample period old
+}
+
+// The ADC that converts a table entry
+static ADC_TypeDef* noseADC(std::size_t index) {
+  return Acquisition.DualADC && (index & 1) ? hadc2.Instance : hadc1.Instance;
+}
+
+// The weaker outer inductor already reads low in a curve, so the watchdog
+// goes on the stronger one alone; it only trips when that one drops too
+void Device::armLineWatch(uint16_t level) {
+  if constexpr (demodulates(Acquisition.Amplitude)) return; // Raw samples swing with the carrier
+  disarmLineWatch();
+  std::size_t watched = ADCRing.latest(outermostNose(true)) > ADCRing.latest(outermostNose(false))
+                      ? outermostNose(true) : outermostNose(false);
+  ADC_TypeDef* adc = noseADC(watched);
+  LineLostLevel = level;
+  WatchedNose = watched;
+  adc->LTR = level;
+  adc->CR1 = (adc->CR1 & ~ADC_CR1_AWDCH) | ADC_CR1_AWDSGL | ADC_CR1_AWDEN | NoseChannels[watched].Channel;
+  adc->SR = ~ADC_SR_AWD; // rc_w0, the other flags are untouched
+  adc->CR1 = adc->CR1 | ADC_CR1_AWDIE;
+}
+
+void Device::disarmLineWatch() {
+  hadc1.Instance->CR1 = hadc1.Instance->CR1 & ~ADC_CR1_AWDIE;
+  hadc2.Instance->CR1 = hadc2.Instance->CR1 & ~ADC_CR1_AWDIE;
+}
+
+bool Device::lineLost() {
+  bool lost = LineLost;
+  LineLost = false;
+  return lost;
+}
+
+int32_t Device::getNosePosition(bool enableFiltering) {
+  // Table indices sorted by position, left to right
+  static constexpr auto order = [](){
+    std::array<uint8_t, ADCChannelCount> o{};
+    for (std::size_t i = 0; i < ADCChannelCount; i++) o[i] = i;
+    std::sort(o.begin(), o.end(), [](uint8_t a, uint8_t b){
+      return NoseChannels[a].Position < NoseChannels[b].Position;
+    });
+    return o;
+  }();
+
+  int64_t x[ADCChannelCount], y[ADCChannelCount];
+  std::size_t peak = 0;
+  for (std::size_t i = 0; i < ADCChannelCount; i++) {
+    x[i] = NoseChannels[order[i]].Position;
+    y[i] = getNoseChannel(order[i], enableFiltering);
+    if (y[i] > y[peak]) peak = i;
+  }
+
+  // Parabola through the peak and its neighbours, when there are neighbours
+  if (peak > 0 && peak + 1 < ADCChannelCount) {
+    int64_t a = x[peak] - x[peak - 1], b = x[peak] - x[peak + 1];
+    int64_t ya = y[peak] - y[peak + 1], yb = y[peak] - y[peak - 1];
+    int64_t den = a * ya - b * yb;
+    if (den != 0) return static_cast<int32_t>(x[peak] - (a * a * ya - b * b * yb) / (2 * den));
+  }
+
+  // Centroid, which for a pair is the normalised (R - L) / (R + L)
+  int64_t sum = 0, moment = 0;
+  for (std::size_t i = 0; i < ADCChannelCount; i++) {
+    sum += y[i];
+    moment += x[i] * y[i];
+  }
+  return sum ? static_cast<int32_t>(moment / sum) : 0;
 }
 
 void Device::setDirection(int32_t rotation) {
@@ -213,6 +342,10 @@ void Device::setDirection(int32_t rotation) {
   *PWM_TIM3_CH3_B0 = duty;
 }
 
+int32_t Device::getDirection() {
+  return static_cast<int32_t>(*PWM_TIM3_CH3_B0) - static_cast<int32_t>(STEER_CENTER);
+}
+
 void Device::setMotorEnabled(bool enabled) {
   if (enabled) {
     HAL_GPIO_WritePin(Enable_IO_GPIO_Port, Enable_IO_Pin, GPIO_PIN_SET);
@@ -223,25 +356,115 @@ void Device::setMotorEnabled(bool enabled) {
 
 void Device::setPower(int32_t power) {
   power = power > POWER_MAX ? POWER_MAX : power < -POWER_MAX ? -POWER_MAX : power;
+  MotorPower = power;
   if (power > 0) {
-    *PWM_TIM4_CH2_B7 = power;
+    *PWM_TIM4_CH2_B7 = power >> MotorShift;
     HAL_GPIO_WritePin(Wheel_Left_IO_GPIO_Port, Wheel_Left_IO_Pin, GPIO_PIN_RESET);
   } else {
-    *PWM_TIM4_CH2_B7 = 4800U + power;
+    *PWM_TIM4_CH2_B7 = (4800U + power) >> MotorShift;
     HAL_GPIO_WritePin(Wheel_Left_IO_GPIO_Port, Wheel_Left_IO_Pin, GPIO_PIN_SET);
   }
 }
 
+int32_t Device::getPower() {
+  return MotorPower;
+}
+
 
 // Dull things
 
 extern "C" {
-  void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc) {
-    if (hadc->Instance == ADC1) {
-      BufferA4.push(ADC_RawValue[0]);
-      BufferC5.push(ADC_RawValue[1]);
+  void Micros_Overflow(void) {
+    MicrosHigh = MicrosHigh + 0x10000;
+  }
+
+  uint32_t Micros(void) {
+    uint32_t high, low, pending;
+    // SR is read inside the loop too, so an update ISR that clears UIF before
+    // we look at it also changes MicrosHigh and forces a retry
+    do {
+      high = MicrosHigh;
+      low = TIM6->CNT;
+      pending = TIM6->SR & TIM_SR_UIF;
+    } while (high != MicrosHigh);
+    // An overflow still pending (we are at or above TIM6's priority) belongs to a low count
+    if (pending && low < 0x8000) high += 0x10000;
+    return high + low;
+  }
+}
+
+// Runs on the half of the DMA ring that starts at `first` once DMA has left it
+static void processBlock(std::size_t first) {
+  NoseBlock block;
+  block.stamp = Micros(); // The block's last frame has just been transferred
+  if constexpr (Acquisition.Amplitude == Estimator::Average) {
+    // Channel by channel, so block stages see contiguous samples
+    int32_t samples[Acquisition.BlockFrames];
+    for (std::size_t ch = 0; ch < ADCChannelCount; ch++) {
+      for (std::size_t i = 0; i < Acquisition.BlockFrames; i++) samples[i] = ADCRing.frame(first + i)[ch];
+      int32_t filtered = NoseFilter[ch].pushBlock(samples, Acquisition.BlockFrames);
+      block.amplitude[ch] = static_cast<uint16_t>(std::clamp<int32_t>(filtered, 0, UINT16_MAX));
+    }
+  } else if constexpr (Acquisition.Amplitude == Estimator::LockIn) {
+    for (std::size_t ch = 0; ch < ADCChannelCount; ch++) {
+      block.amplitude[ch] = LockIn<Acquisition.SamplesPerCycle>::amplitude(
+        ADCRing.frame(first) + ch, ADCChannelCount, Acquisition.BlockFrames);
+    }
+  } else if constexpr (Acquisition.Amplitude == Estimator::Goertzel) {
+    constexpr int16_t Cos = goertzelCos(Acquisition.CarrierHz, Acquisition.SampleRateHz, Acquisition.BlockFrames);
+    for (std::size_t ch = 0; ch < ADCChannelCount; ch++) {
+      block.amplitude[ch] = Goertzel<Acquisition.BlockFrames, Cos>::magnitude(
+        ADCRing.frame(first) + ch, ADCChannelCount);
+    }
+  } else if constexpr (Acquisition.Amplitude == Estimator::Oversample) {
+    using Decimator = Cic<Acquisition.CicOrder, Acquisition.BlockFrames>;
+    constexpr int Shift = std::countr_zero(Decimator::Gain) - Acquisition.ExtraBits;
+    static_assert(Shift >= 0, "Not enough oversampling for ExtraBits");
+    static Decimator decimators[ADCChannelCount];
+    for (std::size_t ch = 0; ch < ADCChannelCount; ch++) {
+      uint32_t sum = decimators[ch].decimate(ADCRing.frame(first) + ch, ADCChannelCount);
+      block.amplitude[ch] = static_cast<uint16_t>((sum + (1u << Shift >> 1)) >> Shift);
     }
   }
+  NoseBlocks.push(block); // Dropped only if pollNose is 32 blocks behind
+  WakePending = true;
+}
+
+extern "C" {
+  void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc) {
+    if (hadc->Instance == ADC1) processBlock(0);
+  }
+
+  // One interrupt per arming, on the stronger outer inductor. The decision
+  // uses the tripping conversion, still in DR: every conversion outlasts
+  // the interrupt entry. In dual mode ADC1->DR also holds the partner
+  // converted at the same instant; any other inductor comes from the ring.
+  void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef* hadc) {
+    hadc->Instance->CR1 = hadc->Instance->CR1 & ~ADC_CR1_AWDIE;
+    std::size_t watched = WatchedNose;
+    std::size_t other = watched == outermostNose(true) ? outermostNose(false) : outermostNose(true);
+    uint32_t pair = hadc1.Instance->DR;
+    auto converted = [pair](std::size_t index) -> uint16_t {
+      return (Acquisition.DualADC && (index & 1) ? pair >> 16 : pair) & 0xFFF;
+    };
+    uint16_t watchedLevel = Acquisition.DualADC ? converted(watched) : hadc->Instance->DR & 0xFFF;
+    uint16_t otherLevel = Acquisition.DualADC && (other ^ 1) == watched ? converted(other) : ADCRing.latest(other);
+    if (watchedLevel >= LineLostLevel || otherLevel >= LineLostLevel) return; // Only a curve
+    // Full lock towards the stronger side, as ControlMode::Max does; setDirection clamps
+    bool right = (watchedLevel > otherLevel ? watched : other) == outermostNose(true);
+    Device::setDirection(right ? INT32_MAX : -INT32_MAX);
+    LineLost = true;
+    WakePending = true;
+  }
+
+  void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc) {
+    if (hadc->Instance == ADC1) processBlock(Acquisition.BlockFrames);
+  }
+
+  // PPM edges; readers poll the pin, so this only ends the main loop's idle
+  void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+    if (GPIO_Pin == PPM_Pin) WakePending = true;
+  }
 }
 
 void Device::sendData(float a, float b) {
@@ -260,6 +483,11 @@ union Convertor {
   uint8_t bytes[4];
 };
 
+void Device::sendData(std::initializer_list<float> datas) {
+  HAL_UART_Transmit(&huart1, (uint8_t*)datas.begin(), datas.size() * sizeof(float), 10);
+  HAL_UART_Transmit(&huart1, (uint8_t*)this->vofaEnd, 4, 10);
+}
+
 void Device::sendDataSafely(const std::vector<float>& datas) {
   for (float data : datas) {
     Convertor convertor;
@@ -312,7 +540,114 @@ void Device::initPWM() {
 }
 
 void Device::initADC() {
+  if constexpr (Acquisition.Mode == AcqMode::Timed) {
+    // One sequence per TIM8 update instead of free-running
+    hadc1.Init.ContinuousConvMode = DISABLE;
+    hadc1.Init.ExternalTrigConv = ADC_EXTERNALTRIGCONV_T8_TRGO;
+    __HAL_AFIO_REMAP_ADC1_ETRGREG_ENABLE(); // TIM8_TRGO replaces EXTI11 as the regular trigger
+  } else if constexpr (Acquisition.Mode == AcqMode::PwmSync) {
+    // One sequence per motor PWM period; ADC2 follows ADC1 in dual mode
+    hadc1.Init.ContinuousConvMode = DISABLE;
+    hadc1.Init.ExternalTrigConv = ADC_EXTERNALTRIGCONV_T4_CC4;
+  }
+  // One rank per table entry; in dual mode ADC1 takes the even entries and
+  // ADC2 the odd ones, so both run sequences of ConversionsPerFrame
+  hadc1.Init.ScanConvMode = ConversionsPerFrame > 1 ? ADC_SCAN_ENABLE : ADC_SCAN_DISABLE;
+  hadc1.Init.NbrOfConversion = ConversionsPerFrame;
+  if constexpr (Acquisition.DualADC) {
+    hadc2.Init.ContinuousConvMode = hadc1.Init.ContinuousConvMode;
+    hadc2.Init.ScanConvMode = hadc1.Init.ScanConvMode;
+    hadc2.Init.NbrOfConversion = ConversionsPerFrame;
+    HAL_ADC_Init(&hadc2);
+  }
+  HAL_ADC_Init(&hadc1);
+
+  // Single-channel watchdog, off until armLineWatch picks the channel and level
+  ADC_AnalogWDGConfTypeDef watchdog = {0};
+  watchdog.WatchdogMode = ADC_ANALOGWATCHDOG_SINGLE_REG;
+  watchdog.Channel = NoseChannels[0].Channel;
+  watchdog.HighThreshold = 4095;
+  watchdog.LowThreshold = 0;
+  watchdog.ITMode = DISABLE;
+  HAL_ADC_AnalogWDGConfig(&hadc1, &watchdog);
+  if constexpr (Acquisition.DualADC) {
+    watchdog.Channel = NoseChannels[1].Channel;
+    HAL_ADC_AnalogWDGConfig(&hadc2, &watchdog);
+  }
+
+  initNosePins();
+  ADC_ChannelConfTypeDef sConfig = {0};
+  sConfig.SamplingTime = static_cast<uint32_t>(Acquisition.Sampling);
+  for (std::size_t i = 0; i < ADCChannelCount; i++) {
+    bool second = Acquisition.DualADC && (i & 1);
+    sConfig.Channel = NoseChannels[i].Channel;
+    sConfig.Rank = ADC_REGULAR_RANK_1 + (Acquisition.DualADC ? i / 2 : i);
+    HAL_ADC_ConfigChannel(second ? &hadc2 : &hadc1, &sConfig);
+  }
+
+  if constexpr (Acquisition.DualADC) {
+    ADC_MultiModeTypeDef multimode = {0};
+    multimode.Mode = ADC_DUALMODE_REGSIMULT;
+    HAL_ADCEx_MultiModeConfigChannel(&hadc1, &multimode);
+    // ADC1->DR now carries both results, ADC2 in the upper half-word
+    hadc1.DMA_Handle->Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    hadc1.DMA_Handle->Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    HAL_DMA_Init(hadc1.DMA_Handle);
+    HAL_ADCEx_Calibration_Start(&hadc2);
+    HAL_ADCEx_Calibration_Start(&hadc1);
+    HAL_ADCEx_MultiModeStart_DMA(&hadc1, ADCRing.target(), ADCHistory::Transfers);
+  } else {
     HAL_ADCEx_Calibration_Start(&hadc1);
     // HAL_Delay(500);
-    HAL_ADC_Start_DMA(&hadc1, (uint32_t *)ADC_RawValue, ADCChannelCount);
+    HAL_ADC_Start_DMA(&hadc1, ADCRing.target(), ADCHistory::Transfers);
+  }
+
+  if constexpr (Acquisition.Mode == AcqMode::Timed) {
+    initSampleTimer();
+  } else if constexpr (Acquisition.Mode == AcqMode::PwmSync) {
+    initPwmSync();
+  }
+}
+
+void Device::initNosePins() {
+  // adc.c only knows A4 and C5, so set every table entry to analog here
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+  GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
+  for (const auto& nose : NoseChannels) {
+    AnalogPin pin = analogPin(nose.Channel);
+    GPIO_InitStruct.Pin = 1u << pin.Pin;
+    HAL_GPIO_Init(pin.Port == 'A' ? GPIOA : pin.Port == 'B' ? GPIOB : GPIOC, &GPIO_InitStruct);
+  }
+}
+
+void Device::initSampleTimer() {
+  // TIM8 is reused as the sample clock, so TIM8_CH1 on C6 follows SampleRateHz
+  TIM_MasterConfigTypeDef sMasterConfig = {0};
+  sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+  sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+  HAL_TIMEx_MasterConfigSynchronization(&htim8, &sMasterConfig);
+
+  __HAL_TIM_SET_PRESCALER(&htim8, 0);
+  __HAL_TIM_SET_AUTORELOAD(&htim8, Acquisition.TimerClockHz / Acquisition.SampleRateHz - 1);
+  TIM8->EGR = TIM_EGR_UG;
+  HAL_TIM_Base_Start(&htim8);
+}
+
+void Device::initPwmSync() {
+  // Center-aligned, the motor output switches at CCR2 on the way up and on the
+  // way down, so the off phase is centered on the counter peak. CC4 (PWM2,
+  // internal only; B9 is a GPIO) matches half a sampling window before it.
+  // Mode 2 raises the CC4 event, the ADC trigger, only while counting up, so
+  // the window straddles the peak and the inductors are sampled as far from
+  // both edges as the duty allows. Mode 1 would fire after the peak.
+  constexpr uint32_t Period = Acquisition.TimerClockHz / Acquisition.MotorPwmHz / 2;
+  constexpr uint32_t SamplingTicks = (conversionHalfCycles(Acquisition.Sampling) - 25)
+                                   * (Acquisition.TimerClockHz / Acquisition.ADCClockHz) / 2;
+  static_assert(SamplingTicks / 2 < Period, "The sampling window is longer than the PWM period");
+  TIM4->CR1 = TIM4->CR1 & ~TIM_CR1_CEN; // CMS may only change while the counter is stopped
+  TIM4->CR1 = (TIM4->CR1 & ~(TIM_CR1_CMS | TIM_CR1_DIR)) | TIM_CR1_CMS_1;
+  __HAL_TIM_SET_AUTORELOAD(&htim4, Period);
+  TIM4->CCMR2 = (TIM4->CCMR2 & ~TIM_CCMR2_OC4M) | TIM_CCMR2_OC4M_0 | TIM_CCMR2_OC4M_1 | TIM_CCMR2_OC4M_2;
+  __HAL_TIM_SET_COMPARE(&htim4, TIM_CHANNEL_4, Period - SamplingTicks / 2);
+  TIM4->EGR = TIM_EGR_UG; // initPWM starts the counter
 }
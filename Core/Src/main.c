@@ -14,6 +14,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "App.h"
+#include "Micros.h"
 
 /* USER CODE END Includes */
 
@@ -89,6 +90,7 @@ int main(void)
   MX_TIM8_Init();
   MX_TIM1_Init();
   MX_ADC1_Init();
+  MX_ADC2_Init();
   /* USER CODE BEGIN 2 */
   App();
 
@@ -173,7 +175,10 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
-
+  if (htim->Instance == TIM6)
+  {
+    Micros_Overflow();
+  }
   /* USER CODE END Callback 1 */
 }
 
@@ -0,0 +1,19 @@
+// HostCycles.h
+// A cycle counter for the host benchmarks
+// Date: Oct 2025
+#pragma once
+#include <chrono>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// TSC cycles on x86, nanoseconds elsewhere; only ratios between kernels are meaningful
+inline uint64_t hostCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
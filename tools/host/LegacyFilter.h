@@ -0,0 +1,55 @@
+// LegacyFilter.h
+// Device::getFiltered as it was before the streaming estimators, for comparison
+// Date: Oct 2025
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Drops the 4 lowest and 4 highest of the 64 samples, then takes a 1.1x
+// geometrically weighted average in soft float. Reads samples[i * stride].
+inline uint16_t legacyFiltered(const volatile uint16_t* samples, std::size_t stride = 1) {
+  const std::size_t count = 64;
+
+  uint16_t minVals[4] = {UINT16_MAX, UINT16_MAX, UINT16_MAX, UINT16_MAX};
+  uint16_t maxVals[4] = {0, 0, 0, 0};
+
+  for (std::size_t i = 0; i < count; i++) {
+    uint16_t val = samples[i * stride];
+    for (int j = 0; j < 4; j++) {
+      if (val < minVals[j]) {
+        for (int k = 3; k > j; k--) minVals[k] = minVals[k - 1];
+        minVals[j] = val;
+        break;
+      }
+    }
+    for (int j = 0; j < 4; j++) {
+      if (val > maxVals[j]) {
+        for (int k = 3; k > j; k--) maxVals[k] = maxVals[k - 1];
+        maxVals[j] = val;
+        break;
+      }
+    }
+  }
+
+  uint64_t weightedSum = 0;
+  uint64_t weightSum = 0;
+  const float base = 1.1f;
+  float weight = 1.0f;
+
+  for (std::size_t i = 0; i < count; i++) {
+    uint16_t val = samples[i * stride];
+    bool isMinMax = false;
+    for (int j = 0; j < 4; j++) {
+      if (val == minVals[j] || val == maxVals[j]) {
+        isMinMax = true;
+        break;
+      }
+    }
+    if (isMinMax) continue;
+    uint64_t w = static_cast<uint64_t>(weight + 0.5f);
+    weightedSum += static_cast<uint64_t>(val) * w;
+    weightSum += w;
+    weight *= base;
+  }
+  return weightSum ? weightedSum / weightSum : samples[(count - 1) * stride];
+}
@@ -0,0 +1,45 @@
+// calibration_check.cpp
+// Calibration's pass-through, endpoints, clamping and monotonic mapping
+// Date: Oct 2025
+#include <cstdio>
+#include <cstdlib>
+#include "Calibration.h"
+
+int main() {
+  constexpr uint16_t FullScale = 4095;
+  Calibration<3, FullScale> cal;
+  int bad = 0;
+
+  // Before the first finish() readings pass through
+  for (uint16_t raw : {0, 1, 2048, 4095}) {
+    if (cal.apply(0, raw) != raw) bad++;
+  }
+
+  // Channel 0 sweeps 500..3500, channel 1 a narrow 64-code range, channel 2 nothing
+  cal.start();
+  for (uint16_t raw = 500; raw <= 3500; raw += 7) cal.record(0, raw);
+  cal.record(0, 3500);
+  cal.record(1, 1000);
+  cal.record(1, 1063);
+  cal.finish();
+  cal.record(0, 4000); // Ignored once finished
+
+  // Endpoints map onto 0 and FullScale, outside values clamp, the midpoint lands in the middle
+  if (cal.apply(0, 500) != 0 || cal.apply(0, 3500) != FullScale) bad++;
+  if (cal.apply(0, 100) != 0 || cal.apply(0, 4095) != FullScale) bad++;
+  if (std::abs(cal.apply(0, 2000) - FullScale / 2) > 1) bad++;
+  // Round trip: the mapped value, scaled back, is within one code of the raw value
+  uint16_t previous = 0;
+  for (uint16_t raw = 500; raw <= 3500; raw++) {
+    uint16_t mapped = cal.apply(0, raw);
+    if (mapped < previous) bad++;
+    previous = mapped;
+    int back = 500 + (mapped * 3000 + FullScale / 2) / FullScale;
+    if (std::abs(back - raw) > 1) bad++;
+  }
+  // Spans below MinSpan and unswept channels keep the old mapping
+  if (cal.apply(1, 1030) != 1030 || cal.apply(2, 1234) != 1234) bad++;
+
+  std::printf("Mismatches: %d\n", bad);
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+// cic_check.cpp
+// Cic against a direct cascade of moving sums, and its DC gain and bit growth
+// Date: Oct 2025
+#include <bit>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Cic.h"
+
+// The Oversample configuration: 32-frame blocks, two extra bits
+constexpr std::size_t BlockFrames = 32;
+constexpr int ExtraBits = 2;
+constexpr uint32_t FullScale = (4096u << ExtraBits) - 1;
+
+// Order moving sums of R samples, read at the end of every block, in 64 bits
+template<std::size_t Order, std::size_t R>
+std::vector<uint64_t> reference(const std::vector<uint16_t>& x) {
+  std::vector<uint64_t> y(x.begin(), x.end());
+  for (std::size_t k = 0; k < Order; k++) {
+    std::vector<uint64_t> sum(y.size());
+    uint64_t acc = 0;
+    for (std::size_t n = 0; n < y.size(); n++) {
+      acc += y[n];
+      if (n >= R) acc -= y[n - R];
+      sum[n] = acc;
+    }
+    y = sum;
+  }
+  std::vector<uint64_t> out;
+  for (std::size_t n = R - 1; n < y.size(); n += R) out.push_back(y[n]);
+  return out;
+}
+
+template<std::size_t Order>
+int check(std::mt19937& rng) {
+  using Decimator = Cic<Order, BlockFrames>;
+  constexpr int Shift = std::countr_zero(Decimator::Gain) - ExtraBits;
+  int bad = 0;
+
+  // Random 12-bit input, long enough for the integrators to wrap
+  std::vector<uint16_t> x(BlockFrames * 20000);
+  for (auto& v : x) v = rng() % 4096;
+  auto expected = reference<Order, BlockFrames>(x);
+  Decimator random;
+  for (std::size_t b = 0; b < expected.size(); b++) {
+    if (random.decimate(&x[b * BlockFrames], 1) != expected[b]) bad++;
+  }
+
+  // DC: once the combs have settled, the output is x * Gain and the
+  // normalised reading is x with ExtraBits more bits, never above FullScale
+  for (uint16_t level : {0, 1, 2048, 4095}) {
+    Decimator dc;
+    std::vector<uint16_t> block(BlockFrames, level);
+    uint32_t sum = 0;
+    for (std::size_t b = 0; b < Order + 1000; b++) sum = dc.decimate(block.data(), 1);
+    uint32_t reading = (sum + (1u << Shift >> 1)) >> Shift;
+    if (sum != level * Decimator::Gain || reading != static_cast<uint32_t>(level) << ExtraBits || reading > FullScale) bad++;
+  }
+
+  std::printf("Order %zu: gain %llu, shift %d, %d mismatches\n", Order,
+              static_cast<unsigned long long>(Decimator::Gain), Shift, bad);
+  return bad;
+}
+
+int main() {
+  std::mt19937 rng(11);
+  int bad = check<1>(rng) + check<2>(rng) + check<3>(rng);
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,59 @@
+// ema_bench.cpp
+// TrimmedEma against the old getFiltered: error on a noisy, spiky sine and cycles
+// Date: Oct 2025
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include "TrimmedEma.h"
+#include "HostCycles.h"
+#include "LegacyFilter.h"
+
+int main() {
+  // 2000 +/- 500 sine, sigma 30 noise, 1/32 spikes of +600
+  constexpr int Samples = 1 << 16;
+  std::mt19937 rng(3);
+  std::normal_distribution<double> noise(0, 30);
+  static uint16_t signal[Samples];
+  static double truth[Samples];
+  for (int i = 0; i < Samples; i++) {
+    truth[i] = 2000 + 500 * std::sin(i * 2 * M_PI / 2000.0);
+    double v = truth[i] + noise(rng);
+    if (rng() % 32 == 0) v += 600;
+    signal[i] = static_cast<uint16_t>(std::clamp(v, 0.0, 4095.0));
+  }
+
+  // Compare once per 64-sample window, the old filter's view
+  TrimmedEma<> filter;
+  volatile uint16_t window[64];
+  double errStreaming = 0, errFiltered = 0, errRaw = 0;
+  int windows = 0;
+  for (int i = 0; i < Samples; i++) {
+    filter.push(signal[i]);
+    window[i % 64] = signal[i];
+    if (i >= 128 && i % 64 == 63) {
+      errStreaming += std::pow(filter.value() - truth[i], 2);
+      errFiltered += std::pow(legacyFiltered(window) - truth[i], 2);
+      errRaw += std::pow(signal[i] - truth[i], 2);
+      windows++;
+    }
+  }
+  double rmsStreaming = std::sqrt(errStreaming / windows);
+  double rmsFiltered = std::sqrt(errFiltered / windows);
+  std::printf("RMS error vs truth: streaming %.1f, getFiltered %.1f, raw %.1f\n",
+              rmsStreaming, rmsFiltered, std::sqrt(errRaw / windows));
+
+  const int runs = 2000;
+  unsigned sink = 0;
+  uint64_t t0 = hostCycles();
+  for (int r = 0; r < runs; r++) {
+    for (int i = 0; i < Samples; i++) filter.push(signal[i]);
+  }
+  uint64_t t1 = hostCycles();
+  for (int r = 0; r < runs * 16; r++) sink += legacyFiltered(&signal[r * 64 % Samples]);
+  uint64_t t2 = hostCycles();
+  std::printf("Cycles: push %.2f per sample, getFiltered %.0f per call (checksum %u)\n",
+              double(t1 - t0) / runs / Samples, double(t2 - t1) / runs / 16, sink + filter.value());
+
+  return rmsStreaming <= rmsFiltered ? 0 : 1;
+}
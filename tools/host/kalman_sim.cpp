@@ -0,0 +1,45 @@
+// kalman_sim.cpp
+// LineKalman in a simulated closed loop: rate and offset error against raw differences
+// Date: Oct 2025
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include "LineKalman.h"
+
+// Setting.Line at NoseScale 1
+constexpr LineModel Model{650, 3277, 2, 4, 40};
+
+int main() {
+  LineKalman<Model> filter;
+  std::mt19937 rng(1);
+  std::normal_distribution<double> sensor(0, 40), drift(0, 4);
+  double y = 0, h = 0;
+  double errRawRate = 0, errRate = 0, errMeasured = 0, errOffset = 0;
+  int previous = 0, steps = 0;
+  for (int k = 0; k < 4000; k++) {
+    // A PD-like steering law, speed steps every 500 periods, jittered dt
+    int steer = static_cast<int>(std::lround(std::clamp(0.04 * y + 0.5 * h, -90.0, 90.0)));
+    int power = 650 + (k / 500 % 2) * 100;
+    double travel = power / 650.0;
+    y += travel * h;
+    h += -travel * Model.SteerGainQ16 / 65536.0 * steer + drift(rng) * 0.25;
+    int z = static_cast<int>(std::lround(y + sensor(rng)));
+    filter.step(z, steer, power, 5000 + (k % 3) * 100, 5000);
+
+    double rate = travel * h;
+    if (k > 100) { // Past the filter's settling
+      errRawRate += std::pow(z - previous - rate, 2);
+      errRate += std::pow(filter.offsetRate() - rate, 2);
+      errMeasured += std::pow(z - y, 2);
+      errOffset += std::pow(filter.offset() - y, 2);
+      steps++;
+    }
+    previous = z;
+  }
+  double rmsRawRate = std::sqrt(errRawRate / steps), rmsRate = std::sqrt(errRate / steps);
+  double rmsMeasured = std::sqrt(errMeasured / steps), rmsOffset = std::sqrt(errOffset / steps);
+  std::printf("Offset rate RMS: raw difference %.1f, filter %.1f\n", rmsRawRate, rmsRate);
+  std::printf("Offset RMS: measured %.1f, filter %.1f\n", rmsMeasured, rmsOffset);
+  return rmsRate < rmsRawRate && rmsOffset < rmsMeasured ? 0 : 1;
+}
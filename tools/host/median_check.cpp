@@ -0,0 +1,27 @@
+// median_check.cpp
+// The median networks against nth_element on random windows
+// Date: Oct 2025
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include "MedianNetwork.h"
+
+template<std::size_t N>
+int check(std::mt19937& rng) {
+  int bad = 0;
+  for (int k = 0; k < 100000; k++) {
+    std::array<uint16_t, N> window;
+    for (auto& x : window) x = rng() % 4096;
+    auto sorted = window;
+    std::nth_element(sorted.begin(), sorted.begin() + N / 2, sorted.end());
+    if (median(window) != sorted[N / 2]) bad++;
+  }
+  std::printf("N=%zu: %zu comparators, %d mismatches\n", N, MedianNet::network<N>.size(), bad);
+  return bad;
+}
+
+int main() {
+  std::mt19937 rng(7);
+  int bad = check<3>(rng) + check<5>(rng) + check<7>(rng) + check<9>(rng);
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,82 @@
+// pipeline_check.cpp
+// Pipeline stages against floating-point references, and pushBlock against push
+// Date: Oct 2025
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "Pipeline.h"
+
+constexpr double SampleHz = 12800;
+constexpr BiquadCoeffs Lowpass = biquadLowpass(500, SampleHz);
+
+// A stage with its own pushBlock, so a block mixes both kinds of stage
+struct Offset {
+  int32_t push(int32_t x) { return x + 1; }
+  void pushBlock(int32_t* samples, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) samples[i] += 1;
+  }
+};
+
+int main() {
+  int bad = 0;
+
+  // Median: primed from the first sample, then drops a lone spike
+  Median<5> median;
+  if (median.push(2000) != 2000 || median.push(4000) != 2000 || median.push(2001) != 2000) bad++;
+
+  // Ema: a step decays by (1 - Alpha) per sample, within the Q8 rounding
+  constexpr double Alpha = 0.2;
+  Ema<Fixed::Q15(Alpha)> ema;
+  ema.push(1000);
+  for (int k = 1; k <= 30; k++) {
+    double expected = 2000 - 1000 * std::pow(1 - Alpha, k);
+    if (std::abs(ema.push(2000) - expected) > 1) bad++;
+  }
+
+  // biquadLowpass: Q14 coefficients within one step of the double-precision RBJ design
+  double w0 = 2 * M_PI * 500 / SampleHz, alpha = std::sin(w0) / (2 * 0.7071), a0 = 1 + alpha;
+  double exact[5] = {(1 - std::cos(w0)) / 2 / a0, (1 - std::cos(w0)) / a0, (1 - std::cos(w0)) / 2 / a0,
+                     -2 * std::cos(w0) / a0, (1 - alpha) / a0};
+  int32_t coeffs[5] = {Lowpass.b0, Lowpass.b1, Lowpass.b2, Lowpass.a1, Lowpass.a2};
+  for (int i = 0; i < 5; i++) {
+    if (std::abs(coeffs[i] - exact[i] * 16384) > 1) bad++;
+  }
+
+  // Biquad: unity at DC, and a 3 kHz tone well below the 500 Hz cutoff's passband
+  Biquad<Lowpass> dc;
+  int32_t settled = 0;
+  for (int n = 0; n < 2000; n++) settled = dc.push(2000);
+  if (std::abs(settled - 2000) > 2) bad++;
+  Biquad<Lowpass> tone;
+  double peak = 0;
+  for (int n = 0; n < 4000; n++) {
+    int32_t y = tone.push(static_cast<int32_t>(std::lround(2048 + 1000 * std::sin(2 * M_PI * 3000 * n / SampleHz))));
+    if (n > 2000) peak = std::max(peak, std::abs(y - 2048.0));
+  }
+  double attenuation = 20 * std::log10(1000 / std::max(peak, 1.0));
+  if (attenuation < 30) bad++;
+
+  // pushBlock equals per-sample push through a full chain on spiky noise
+  using Chain = Pipeline<Median<5>, Ema<Fixed::Q15(0.2)>, Biquad<Lowpass>, Trimmed<>, Offset>;
+  Chain perSample, perBlock;
+  std::mt19937 rng(17);
+  std::normal_distribution<double> noise(0, 30);
+  std::vector<int32_t> x(4096);
+  for (auto& v : x) v = static_cast<int32_t>(2000 + noise(rng) + (rng() % 16 == 0 ? 800 : 0));
+  std::vector<int32_t> block = x;
+  for (std::size_t i = 0; i < block.size(); i += 32) perBlock.pushBlock(&block[i], 32);
+  int64_t tail = 0;
+  for (std::size_t i = 0; i < x.size(); i++) {
+    int32_t y = perSample.push(x[i]);
+    if (y != block[i]) bad++;
+    if (i >= x.size() - 1024) tail += y;
+  }
+  // Settles on the level, which Offset raises by one. Spikes that share a
+  // window with noise still nudge the median's rank up by a few codes
+  if (std::abs(tail / 1024.0 - 2001) > 10) bad++;
+
+  std::printf("Mismatches: %d (3 kHz attenuated %.1f dB)\n", bad, attenuation);
+  return bad ? 1 : 0;
+}
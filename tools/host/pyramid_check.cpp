@@ -0,0 +1,48 @@
+// pyramid_check.cpp
+// HistoryPyramid's per-level range and slope against the raw samples they cover
+// Date: Oct 2025
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "HistoryPyramid.h"
+
+int main() {
+  constexpr std::size_t N = 16, Levels = 3, Ratio = 10;
+  using Pyramid = HistoryPyramid<int32_t, N, Levels, Ratio>;
+  int bad = 0;
+
+  // A random walk; before the first push every level holds the first value
+  Pyramid pyramid;
+  std::mt19937 rng(13);
+  std::vector<int32_t> samples(N * Pyramid::bucketSpan(Levels - 1), 0);
+  int32_t v = 100;
+  for (int t = 0; t < 5000; t++) {
+    v += static_cast<int32_t>(rng() % 41) - 20;
+    samples.push_back(v);
+    pyramid.push(v);
+    if (t == 0) std::fill(samples.begin(), samples.end() - 1, v);
+    if ((t + 1) % Pyramid::bucketSpan(Levels - 1)) continue;
+    // Complete buckets only, so each level covers exactly its last N * span samples
+    for (std::size_t i = 0; i < Levels; i++) {
+      auto first = samples.end() - N * Pyramid::bucketSpan(i);
+      int64_t sum = 0;
+      for (auto it = first; it != samples.end(); it++) sum += *it;
+      auto range = pyramid.range(i);
+      int32_t mean = static_cast<int32_t>(sum / static_cast<int64_t>(N * Pyramid::bucketSpan(i)));
+      if (range.min != *std::min_element(first, samples.end()) || range.max != *std::max_element(first, samples.end())) bad++;
+      if (std::abs(range.mean - mean) > static_cast<int32_t>(i) + 1) bad++; // Each level truncates once
+    }
+  }
+
+  // A ramp of 3 per sample reads as 3 per sample at every level
+  Pyramid ramp;
+  for (int t = 0; t < 5000; t++) ramp.push(3 * t);
+  for (std::size_t i = 0; i < Levels; i++) {
+    if (std::abs(ramp.slope(i) - (3 << 8)) > 1) bad++;
+  }
+
+  std::printf("Mismatches: %d (sizeof %zu bytes)\n", bad, sizeof(Pyramid));
+  return bad ? 1 : 0;
+}
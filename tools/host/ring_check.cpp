@@ -0,0 +1,36 @@
+// ring_check.cpp
+// RingBuffer indexing, sliding min/max and segments against a brute-force window
+// Date: Oct 2025
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <random>
+#include "RingBuffer.h"
+
+int main() {
+  constexpr int N = 16;
+  RingBuffer<int32_t, N> ring;
+  std::array<int32_t, N> window{}; // Oldest first, starts full of zeros like the ring
+  std::mt19937 rng(5);
+  int bad = 0;
+  for (int i = 0; i < 200000; i++) {
+    // Repeats exercise the ties in the deques
+    int32_t v = i % 7 == 0 ? ring[-1] : static_cast<int32_t>(rng() % 2001) - 1000;
+    ring.push(v);
+    std::rotate(window.begin(), window.begin() + 1, window.end());
+    window[N - 1] = v;
+    if (ring.getMax() != *std::max_element(window.begin(), window.end())) bad++;
+    if (ring.getMin() != *std::min_element(window.begin(), window.end())) bad++;
+    for (int k = -N; k < N; k++) {
+      if (ring[k] != window[(k + N) % N]) bad++;
+    }
+    // The two runs, joined, are the window oldest first
+    auto [older, newer] = ring.segments();
+    if (older.size() + newer.size() != N || !std::equal(older.begin(), older.end(), window.begin())
+        || !std::equal(newer.begin(), newer.end(), window.begin() + older.size())) bad++;
+  }
+  RingBuffer<int32_t, 4> empty;
+  if (empty.getMax() != 0 || empty.getMin() != 0) bad++;
+  std::printf("Mismatches: %d\n", bad);
+  return bad ? 1 : 0;
+}
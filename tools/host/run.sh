@@ -0,0 +1,38 @@
+#!/bin/bash
+
+# run.sh
+# Builds and runs the host-side benchmarks and checks for the header-only kernels
+# Needs a host g++ with C++20; the firmware toolchain is not involved
+# Date: Oct 2025
+
+set -e
+
+ROOT_DIR="$(cd "$(dirname "$0")/../.." && pwd)"
+HOST_DIR="$ROOT_DIR/tools/host"
+BUILD_DIR="$ROOT_DIR/build/host"
+CXXFLAGS="-std=c++20 -O2 -Wall -Wextra -pthread -I$ROOT_DIR/Core/Inc -I$HOST_DIR"
+# Device.h, which the scheduler check pulls in, needs the HAL headers
+CXXFLAGS+=" -DSTM32F103xE -DUSE_HAL_DRIVER -I$ROOT_DIR/Drivers/STM32F1xx_HAL_Driver/Inc"
+CXXFLAGS+=" -I$ROOT_DIR/Drivers/CMSIS/Device/ST/STM32F1xx/Include -I$ROOT_DIR/Drivers/CMSIS/Include"
+
+mkdir -p "$BUILD_DIR"
+
+# ./run.sh            runs everything
+# ./run.sh ring_check runs one program by name
+PROGRAMS=("$@")
+if [[ ${#PROGRAMS[@]} -eq 0 ]]; then
+    for src in "$HOST_DIR"/*.cpp; do
+        PROGRAMS+=("$(basename "$src" .cpp)")
+    done
+fi
+
+failed=0
+for name in "${PROGRAMS[@]}"; do
+    echo -e "\033[1;32m::\033[0m \033[1m$name\033[0m"
+    g++ $CXXFLAGS "$HOST_DIR/$name.cpp" -o "$BUILD_DIR/$name"
+    if ! "$BUILD_DIR/$name"; then
+        echo -e "\033[1;31m==> FAILED:\033[0m $name"
+        failed=1
+    fi
+done
+exit $failed
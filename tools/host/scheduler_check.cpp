@@ -0,0 +1,128 @@
+// scheduler_check.cpp
+// The pooled, deadline-ordered Scheduler against the old one on random task sets
+// Date: Oct 2025
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "ScheduledTask.h"
+#include "LegacyScheduler.h"
+
+// What fired in one pass, sorted: the old scheduler ticks in list order,
+// the new one earliest first, and only the set per pass must match
+using Trace = std::vector<std::string>;
+
+template<typename S>
+struct Context {
+  S* scheduler;
+  Trace* fired;
+};
+
+// The same calls through either API
+struct Pooled {
+  using Scheduler = ::Scheduler;
+  template<typename F> static Task task(uint32_t period, F cb, uint32_t runs) { return makeTask(period, cb, runs); }
+  template<typename F> static Task delayed(uint32_t delay, uint32_t period, F cb, uint32_t runs) { return makeTask(delay, period, cb, runs); }
+  template<typename F> static Task steps(uint32_t period, F cb, uint32_t runs) { return makeStepTask<5>(period, cb, runs); }
+};
+struct Old {
+  using Scheduler = Legacy::Scheduler;
+  template<typename F> static auto task(uint32_t period, F cb, uint32_t runs) { return Legacy::makeTask(period, cb, runs); }
+  template<typename F> static auto delayed(uint32_t delay, uint32_t period, F cb, uint32_t runs) { return Legacy::makeTask(delay, period, cb, runs); }
+  template<typename F> static auto steps(uint32_t period, F cb, uint32_t runs) { return Legacy::makeStepTask<5>(period, cb, runs); }
+};
+
+template<typename Api>
+std::vector<std::string> simulate(uint32_t seed, bool& early) {
+  using S = typename Api::Scheduler;
+  alignas(8) static char storage[sizeof(Device)]; // The callbacks never touch the device
+  Device& dev = *reinterpret_cast<Device*>(storage);
+  std::mt19937 rng(seed);
+  S scheduler(0);
+  Trace fired;
+  Context<S> ctx{&scheduler, &fired};
+  std::vector<std::string> passes;
+
+  auto add = [&](int n, uint32_t start) {
+    uint32_t period = 1 + rng() % 60, delay = rng() % 30;
+    uint32_t runs = rng() % 3 ? INF_RUNS : 1 + rng() % 10;
+    switch (rng() % 5) {
+      case 0:
+        scheduler.addTaskAndInit(Api::task(period, [ctx, n](Device&){
+          ctx.fired->push_back("t" + std::to_string(n));
+        }, runs), start);
+        break;
+      case 1:
+        scheduler.addTaskAndInit(Api::delayed(delay, period, [ctx, n](Device&){
+          ctx.fired->push_back("d" + std::to_string(n));
+        }, runs), start);
+        break;
+      case 2:
+        scheduler.addTaskAndInit(Api::steps(period * 5, [ctx, n](Device&, std::size_t step){
+          ctx.fired->push_back("s" + std::to_string(n) + "." + std::to_string(step));
+        }, runs), start);
+        break;
+      case 3: // Removes itself from inside its callback, as App's stop check does
+        scheduler.addTaskAndInit(Api::task(period, [ctx, n](Device&){
+          ctx.fired->push_back("r" + std::to_string(n));
+          ctx.scheduler->removeTask(ctx.scheduler->currentTaskId());
+        }, INF_RUNS), start);
+        break;
+      case 4: // Adds a one-shot task during the run, which joins after it
+        scheduler.addTaskAndInit(Api::task(period, [ctx, n](Device&){
+          ctx.fired->push_back("a" + std::to_string(n));
+          ctx.scheduler->addTaskAndInit(Api::task(3, [ctx, n](Device&){
+            ctx.fired->push_back("o" + std::to_string(n));
+          }, 1), 0);
+        }, 4), start);
+        break;
+    }
+  };
+
+  // At most Initial tasks plus one pending one-shot each, inside the pool
+  constexpr int Initial = 7;
+  static_assert(2 * Initial <= MaxTasks);
+  for (int n = 0; n < Initial; n++) add(n, 0);
+  uint32_t now = 0;
+  int next = Initial;
+  for (int k = 0; k < 5000; k++) {
+    now += rng() % 4 == 0 ? rng() % 20 : 1;
+    // Outside a run: add a task or remove one by id now and then
+    if (rng() % 50 == 0 && scheduler.taskCount() < Initial) add(next++, now);
+    if (rng() % 80 == 0) scheduler.removeTask(1 + rng() % next);
+    uint32_t deadline = 0;
+    if constexpr (std::is_same_v<Api, Pooled>) deadline = scheduler.nextDeadline();
+    fired.clear();
+    scheduler.runOnce(dev, now);
+    // Nothing may fire before nextDeadline, or idleUntil would sleep through it
+    if constexpr (std::is_same_v<Api, Pooled>) {
+      if (!fired.empty() && static_cast<int32_t>(now - deadline) < 0) early = true;
+    }
+    std::sort(fired.begin(), fired.end());
+    std::string pass = std::to_string(now) + ":";
+    for (auto& f : fired) pass += " " + f;
+    passes.push_back(pass);
+  }
+  return passes;
+}
+
+int main() {
+  int bad = 0;
+  for (uint32_t seed = 1; seed <= 50; seed++) {
+    bool early = false, unused = false;
+    auto pooled = simulate<Pooled>(seed, early);
+    auto old = simulate<Old>(seed, unused);
+    auto diff = std::mismatch(pooled.begin(), pooled.end(), old.begin());
+    if (diff.first != pooled.end()) {
+      std::printf("Seed %u differs:\n  new %s\n  old %s\n", seed, diff.first->c_str(), diff.second->c_str());
+      bad++;
+    }
+    if (early) {
+      std::printf("Seed %u: a task fired before nextDeadline()\n", seed);
+      bad++;
+    }
+  }
+  std::printf("Seeds with mismatches: %d of 50\n", bad);
+  return bad ? 1 : 0;
+}
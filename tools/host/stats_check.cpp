@@ -0,0 +1,40 @@
+// stats_check.cpp
+// StatsBuffer's running sum, variance and slope against a direct recompute
+// Date: Oct 2025
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include "StatsBuffer.h"
+
+int main() {
+  constexpr int N = 16;
+  StatsBuffer<int32_t, N> stats;
+  std::mt19937 rng(1);
+  int bad = 0;
+  for (int i = 0; i < 100000; i++) {
+    stats.push(static_cast<int32_t>(rng() % 8001) - 4000);
+    int64_t sum = 0;
+    uint64_t sumSq = 0;
+    for (int k = 0; k < N; k++) {
+      sum += stats[k];
+      sumSq += static_cast<int64_t>(stats[k]) * stats[k];
+    }
+    uint64_t variance = (sumSq * N - static_cast<uint64_t>(sum * sum)) / (N * N);
+    if (sum != stats.getSum() || variance != stats.variance()) bad++;
+    uint32_t sd = stats.stddev();
+    if (static_cast<uint64_t>(sd) * sd > variance || static_cast<uint64_t>(sd + 1) * (sd + 1) <= variance) bad++;
+    // Least-squares slope against position, within one Q8 step of the exact value
+    double meanX = (N - 1) / 2.0, meanY = static_cast<double>(sum) / N, sxy = 0, sxx = 0;
+    for (int k = 0; k < N; k++) {
+      sxy += (k - meanX) * (stats[k] - meanY);
+      sxx += (k - meanX) * (k - meanX);
+    }
+    if (std::abs(sxy / sxx * 256 - stats.slope()) > 1) bad++;
+  }
+  // A ramp of 10 per push has slope exactly 10
+  for (int k = 0; k < N; k++) stats.push(10 * k - 70);
+  if (stats.slope() != 10 << 8) bad++;
+  std::printf("Mismatches: %d (last mean %d, variance %llu, stddev %u)\n", bad, stats.mean(),
+              static_cast<unsigned long long>(stats.variance()), stats.stddev());
+  return bad ? 1 : 0;
+}